@@ -5,10 +5,17 @@
 #define EventAction_h 1
 
 #include "analysis/TupleVectorContainer.hh"
+#include "gas_chamber/GasChamberStepStore.hh"
+#include "gas_chamber/GasChamberTrackSummary.hh"
+#include "recorder/RecorderNtuple.hh"
+#include "digitizer/GasChamberDigitizer.hh"
+#include "digitizer/DigitizerNtuple.hh"
 #include "G4UserEventAction.hh"
 #include "G4GenericMessenger.hh"
 #include "globals.hh"
 
+class G4VHitsCollection;
+
 /// Event action
 class EventAction : public G4UserEventAction
 {
@@ -20,7 +27,24 @@ class EventAction : public G4UserEventAction
     virtual void EndOfEventAction(const G4Event*);
 
     vector<G4double> *GetVectorPtrD(const std::string &tName, const std::string &vecName) const;
+    vector<G4float> *GetVectorPtrF(const std::string &tName, const std::string &vecName) const;
     vector<G4int> *GetVectorPtrI(const std::string &tName, const std::string &vecName) const;
+    // ntuples of ancillary detectors enabled in parameters/ancillary.txt
+    const std::vector<RecorderNtupleBase *> &GetRecorderNtuples() const { return fRecorderNtuples; }
+    // nullptr if the digitizer is disabled in parameters/digitizer.txt
+    DigitizerNtuple *GetDigitizerNtuple() const { return fDigitizerNtuple; }
+
+    // events processed by this thread in the current run, for the shard manifest of RunAction
+    void ResetEventRange();
+    G4int GetNbOfEvents() const { return fNbOfEvents; }
+    G4int GetFirstEventId() const { return fFirstEventId; }
+    G4int GetLastEventId() const { return fLastEventId; }
+    // whether tree_gc2 has one row per event instead of one row per track, by layout in parameters/gas_chamber.txt
+    G4bool IsEventLayout() const { return fEventLayout; }
+    // whether per-track summaries are written in tree_gc2, by trackSummary in parameters/gas_chamber.txt
+    G4bool HasTrackSummary() const { return fWriteSummary; }
+    // step columns written in tree_gc2, none if only the summaries are written
+    const std::vector<GasChamberStepStore::Column> &GetBookedStepColumns() const { return fBookedStepColumns; }
 
     protected:
     G4int verboseLevel;
@@ -35,9 +59,18 @@ class EventAction : public G4UserEventAction
     // for gas chamber SD
     void InitNtuplesVectorGasChamber();
     void FillNtupleGasChamber();
+    // rows of the step ntuples handed to AsyncNtupleWriter in the asynchronous output mode
+    void FillNtupleGasChamberAsync(G4VHitsCollection *hitCol);
+    // per-track arrays and flat step arrays of the event layout of tree_gc2
+    void FillEventLayoutVectors(G4VHitsCollection *hitCol);
     void PrintGasChamberHits();
 
-    // method for another SD can be added in the same way
+    // for gas chamber voxel SD
+    void InitNtuplesVectorGasChamberVoxel();
+    void FillNtupleGasChamberVoxel();
+
+    // Another SD can be added in the same way, or declared as an ancillary detector
+    // in recorder/AncillaryRecorders.hh to be recorded by RecorderNtuple.
 
     // for UI command
     void DefineCommands();
@@ -46,11 +79,42 @@ class EventAction : public G4UserEventAction
     G4bool fHcIdsInitialized;
     // hit collections Ids
     G4int fGasChamberHcId;
+    G4int fGasChamberVoxelHcId;
     G4GenericMessenger *fMessenger;
 
     // vector container
     TupleVectorContainerD *fVectorContainerD;    
+    TupleVectorContainerF *fVectorContainerF;
     TupleVectorContainerI *fVectorContainerI;    
+
+    // step columns of tree_gc2 and the vectors bound to them by storage type, resolved once in the constructor.
+    std::vector<std::pair<GasChamberStepStore::Column, vector<G4double> *> > fGasChamberStepVectors;
+    std::vector<std::pair<GasChamberStepStore::Column, vector<G4float> *> > fGasChamberStepVectorsF;
+    std::vector<std::pair<GasChamberStepStore::Column, vector<G4int> *> > fGasChamberStepVectorsI;
+    // columns of tree_gc3
+    vector<G4int> *fVoxelIds;
+    vector<G4float> *fVoxelEdeps;
+
+    std::vector<RecorderNtupleBase *> fRecorderNtuples;
+
+    // digitizer of the gas chamber, created at the first event of a worker and owned by G4DigiManager.
+    GasChamberDigitizer *fDigitizer;
+    DigitizerNtuple *fDigitizerNtuple;
+
+    // events of the current run
+    G4int fNbOfEvents;
+    G4int fFirstEventId, fLastEventId;
+
+    // per-track columns of the event layout of tree_gc2, and offsets of the steps of tracks
+    G4bool fEventLayout;
+    vector<G4int> *fTrackIds, *fTrackNbOfSteps, *fTrackAtomicNumbers, *fStepOffsets;
+    vector<G4double> *fTrackMasses, *fTrackLengths, *fTrackEdepSums;
+
+    // per-track summaries, as arrays in the event layout
+    G4bool fWriteSummary;
+    std::array<vector<G4double> *, GasChamberTrackSummary::kNbOfValues> fSummaryVectors;
+    GasChamberTrackSummary fSummary;
+    std::vector<GasChamberStepStore::Column> fBookedStepColumns;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
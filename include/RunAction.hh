@@ -5,10 +5,13 @@
 #define RunAction_h 1
 
 #include "AnalysisManager.hh"
+#include "analysis/OutputSettings.hh"
 #include "G4UserRunAction.hh"
 #include "G4GenericMessenger.hh"
 #include "globals.hh"
 
+#include <map>
+
 class EventAction;
 
 class G4Run;
@@ -26,12 +29,43 @@ class RunAction : public G4UserRunAction
     private:
     // create tuples in AnalysisManager for each detector SD
     void CreateTuplesGasChamber();
+    void CreateTuplesAncillary();
+    // book tree_gc1 and tree_gc2 in the asynchronous writer, with the same columns and ids
+    void CreateTuplesGasChamberAsync();
+
+    // file name without the .root extension, to which suffixes of other files are appended
+    G4String GetFileStem() const;
+    // whether the file of this thread has ntuple rows, which is not the case for the master of a
+    // multithreaded run with shards, or for workers whose rows are merged
+    G4bool HasNtupleRows() const;
+    // file written by G4AnalysisManager on this thread
+    G4String GetThreadFileName() const;
+    // Add the file of this thread to the shard manifest, and write the manifest on the master.
+    void AddShard();
+
+    // compression and basket settings of the output files and their ntuples
+    void SetCompression(const G4String &compression);
+    void SetBasketSize(G4int basketSize);
+    void SetAutoFlush(G4int autoFlush);
+    // given as "<ntuple>,<value>"
+    void SetNtupleCompression(const G4String &ntupleCompression);
+    void SetNtupleBasketSize(const G4String &ntupleBasketSize);
+    void SetNtupleAutoFlush(const G4String &ntupleAutoFlush);
+    // Apply the settings to G4AnalysisManager and the asynchronous writer before files are opened.
+    void ApplyOutputSettings(G4bool async);
 
     // for messenger and UI
     void DefineCommands();
     private:
     G4bool fAnaActivated;
     G4String fFileName;
+    // tree_gc1 and tree_gc2 are written by AsyncNtupleWriter to a separate file if set
+    G4bool fAsyncOutput;
+    G4int fAsyncQueueSize;
+    // Each worker writes its ntuples to <stem>_t<threadId>.root without merging, listed in <stem>_shards.txt.
+    G4bool fShardOutput;
+    OutputSettings fOutputSettings;
+    std::map<G4String, OutputSettings> fNtupleOutputSettings;
     EventAction *fEventAction;
     G4AnalysisManager *fAnalysisManager;
     G4GenericMessenger *fMessenger;
@@ -0,0 +1,136 @@
+/// \file AsyncNtupleWriter.hh
+/// \brief Definition of the AsyncNtupleWriter class
+
+#ifndef AsyncNtupleWriter_h
+#define AsyncNtupleWriter_h 1
+
+#include "analysis/BoundedQueue.hh"
+#include "analysis/OutputSettings.hh"
+#include "globals.hh"
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Values of one row of an ntuple of AsyncNtupleWriter, by column type in the order of booking.
+struct NtupleRow
+{
+    G4int ntupleId = -1;
+    std::vector<G4int> ints;
+    std::vector<G4float> floats;
+    std::vector<G4double> doubles;
+    std::vector<std::vector<G4int>> intVectors;
+    std::vector<std::vector<G4float>> floatVectors;
+    std::vector<std::vector<G4double>> doubleVectors;
+};
+
+/// Rows of the ntuples of a finished event.
+/// Records are recycled after they are written, so rows and their vectors keep their capacity.
+struct EventRecord
+{
+    std::vector<NtupleRow> rows;
+    G4int nbOfRows = 0;
+
+    void Clear() { nbOfRows = 0; }
+    // new row of an ntuple with its scalars cleared, whose vector columns are to be assigned.
+    NtupleRow &AddRow(G4int ntupleId)
+    {
+        if(nbOfRows == static_cast<G4int>(rows.size()))
+            rows.emplace_back();
+        auto &row = rows[nbOfRows++];
+        row.ntupleId = ntupleId;
+        row.ints.clear();
+        row.floats.clear();
+        row.doubles.clear();
+        return row;
+    }
+};
+
+/// Writer of ntuples on a dedicated thread, for the asynchronous output mode of RunAction.
+///
+/// Worker threads fill an EventRecord at the end of each event and hand it to a BoundedQueue,
+/// from which the writer thread fills the trees, so that ROOT serialization and compression
+/// run off the event loop. A worker waits while the queue is full, so memory stays bounded
+/// by the queue size. Written records go back to a pool to be reused by the workers.
+/// Ntuples are booked by the master before Open(), and ntuple ids are given in booking order.
+class AsyncNtupleWriter
+{
+    public:
+    enum ColumnType
+    {
+        kInt, kFloat, kDouble, kIntVector, kFloatVector, kDoubleVector
+    };
+
+    public:
+    static AsyncNtupleWriter *GetInstance();
+
+    // Clear booked ntuples, before booking those of a new file.
+    void ClearNtuples();
+    G4int CreateNtuple(const G4String &name, const G4String &title);
+    void CreateColumn(G4int ntupleId, const G4String &name, ColumnType type);
+
+    // settings of the file and of its ntuples by name, applied when the file is opened
+    void SetOutputSettings(const OutputSettings &fileSettings, const std::map<G4String, OutputSettings> &ntupleSettings);
+
+    // Open the file with the booked ntuples and start the writer thread.
+    void Open(const G4String &fileName, G4int queueSize);
+    // Write the remaining records, close the file and stop the writer thread.
+    void Close();
+    G4bool IsOpen() const { return fOpen.load(std::memory_order_acquire); }
+
+    // empty record to be filled by a worker
+    EventRecord *AcquireRecord();
+    // Hand a filled record to the writer thread, waiting while the queue is full.
+    void Push(EventRecord *record);
+
+    private:
+    AsyncNtupleWriter();
+    ~AsyncNtupleWriter();
+
+    struct Ntuple
+    {
+        G4String name, title;
+        std::vector<std::pair<G4String, ColumnType>> columns;
+        TTree *tree = nullptr;
+        // column buffers bound to the branches
+        std::vector<Int_t> ints;
+        std::vector<Float_t> floats;
+        std::vector<Double_t> doubles;
+        std::vector<std::vector<Int_t>> intVectors;
+        std::vector<std::vector<Float_t>> floatVectors;
+        std::vector<std::vector<Double_t>> doubleVectors;
+    };
+
+    void CreateBranches(Ntuple &ntuple);
+    void Run();
+    void Write(EventRecord *record);
+    void Release(EventRecord *record);
+
+    private:
+    std::vector<std::unique_ptr<Ntuple>> fNtuples;
+    OutputSettings fFileSettings;
+    std::map<G4String, OutputSettings> fNtupleSettings;
+    TFile *fFile;
+    std::thread fThread;
+    std::atomic<G4bool> fOpen, fStop;
+    std::unique_ptr<BoundedQueue<EventRecord>> fQueue, fFreeRecords;
+    // waiting of the writer for records and of workers for room in the queue
+    std::mutex fWaitMutex;
+    std::condition_variable fNotEmpty, fNotFull;
+    // statistics of a file
+    std::atomic<G4long> fNbOfWaits;
+    G4long fNbOfRecords;
+    G4double fWriteTime;
+    std::vector<OutputSettings::TreeSize> fTreeSizes;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
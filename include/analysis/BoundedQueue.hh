@@ -0,0 +1,110 @@
+/// \file BoundedQueue.hh
+/// \brief Definition of the BoundedQueue class
+
+#ifndef BoundedQueue_h
+#define BoundedQueue_h 1
+
+#include "globals.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/// Bounded lock-free queue of pointers for several producers and consumers (D. Vyukov's algorithm).
+///
+/// Every cell has a sequence number telling whether it is ready to be written or read in the current lap,
+/// so a push or a pop takes one compare-and-swap on the position and never waits for a lock.
+/// TryPush() fails if the queue is full, and TryPop() if it is empty; blocking is left to the caller.
+/// The capacity is rounded up to a power of two.
+template<typename T>
+class BoundedQueue
+{
+    public:
+    BoundedQueue(std::size_t capacity)
+        : fMask(RoundUp(capacity) - 1), fCells(new Cell[fMask + 1]), fEnqueuePos(0), fDequeuePos(0)
+    {
+        for(std::size_t i = 0;i <= fMask;++i)
+            fCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    G4bool TryPush(T *value)
+    {
+        std::size_t pos = fEnqueuePos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while(true)
+        {
+            cell = &fCells[pos & fMask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if(diff == 0)
+            {
+                if(fEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if(diff < 0)
+                return false;
+            else
+                pos = fEnqueuePos.load(std::memory_order_relaxed);
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    G4bool TryPop(T *&value)
+    {
+        std::size_t pos = fDequeuePos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while(true)
+        {
+            cell = &fCells[pos & fMask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if(diff == 0)
+            {
+                if(fDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if(diff < 0)
+                return false;
+            else
+                pos = fDequeuePos.load(std::memory_order_relaxed);
+        }
+        value = cell->value;
+        cell->sequence.store(pos + fMask + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t GetCapacity() const { return fMask + 1; }
+    // number of elements, approximate while other threads push or pop
+    std::size_t GetSize() const
+    {
+        return fEnqueuePos.load(std::memory_order_relaxed) - fDequeuePos.load(std::memory_order_relaxed);
+    }
+
+    private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T *value;
+    };
+
+    static std::size_t RoundUp(std::size_t n)
+    {
+        std::size_t capacity = 2;
+        while(capacity < n)
+            capacity *= 2;
+        return capacity;
+    }
+
+    private:
+    const std::size_t fMask;
+    std::unique_ptr<Cell[]> fCells;
+    // positions of producers and consumers on separate cache lines
+    alignas(64) std::atomic<std::size_t> fEnqueuePos;
+    alignas(64) std::atomic<std::size_t> fDequeuePos;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,79 @@
+/// \file OutputSettings.hh
+/// \brief Definition of the OutputSettings class
+
+#ifndef OutputSettings_h
+#define OutputSettings_h 1
+
+#include "globals.hh"
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include <vector>
+
+/// Compression and basket settings of a ROOT output file or of one of its ntuples.
+///
+/// Settings left unset keep the defaults of ROOT, and those of an ntuple left unset
+/// fall back to the settings of its file (see Override()).
+/// Compression is given as "<algorithm>:<level>" with algorithm zlib, lzma, lz4 or zstd,
+/// "none" for no compression, or "default".
+/// Auto-flush is in entries if positive and in bytes if negative, as for TTree::SetAutoFlush().
+class OutputSettings
+{
+    public:
+    // uncompressed and compressed sizes of a written tree
+    struct TreeSize
+    {
+        G4String name;
+        G4double totBytes = 0., zipBytes = 0.;
+    };
+
+    public:
+    OutputSettings();
+
+    // false if the compression cannot be parsed, in which case the settings are unchanged
+    G4bool SetCompression(const G4String &compression);
+    G4bool HasCompression() const { return fAlgorithm >= 0; }
+    // algorithm numbered as ROOT::RCompressionSetting::EAlgorithm
+    G4int GetAlgorithm() const { return fAlgorithm; }
+    G4int GetLevel() const { return fLevel; }
+    // 100*algorithm + level, as for TFile::SetCompressionSettings()
+    G4int GetCompressionSettings() const { return 100*fAlgorithm + fLevel; }
+    G4String GetCompressionName() const;
+
+    void SetBasketSize(G4int basketSize) { fBasketSize = basketSize; }
+    G4int GetBasketSize() const { return fBasketSize; }
+    void SetAutoFlush(G4int autoFlush) { fAutoFlush = autoFlush; }
+    G4int GetAutoFlush() const { return fAutoFlush; }
+
+    // these settings, replaced by those set in ntupleSettings
+    OutputSettings Override(const OutputSettings &ntupleSettings) const;
+
+    // to be applied before the trees are created
+    void Apply(TFile *file) const;
+    // to be applied after the branches are created and before the first fill
+    void Apply(TTree *tree) const;
+
+    static std::vector<TreeSize> GetTreeSizes(const std::vector<TTree *> &trees);
+    // sizes of the trees of a closed file
+    static std::vector<TreeSize> GetTreeSizes(const G4String &fileName);
+    // Print the compression ratio of each tree and of the file, with a time labelled by what it covers.
+    static void PrintCompression(const G4String &fileName, const std::vector<TreeSize> &sizes,
+        G4double time, const G4String &timeLabel);
+
+    public:
+    // ROOT::RCompressionSetting::EAlgorithm
+    enum Algorithm
+    {
+        kZLIB = 1, kLZMA = 2, kLZ4 = 4, kZSTD = 5
+    };
+
+    private:
+    G4int fAlgorithm, fLevel;
+    G4int fBasketSize;
+    G4int fAutoFlush;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,57 @@
+/// \file ShardManifest.hh
+/// \brief Definition of the ShardManifest class
+
+#ifndef ShardManifest_h
+#define ShardManifest_h 1
+
+#include "globals.hh"
+
+#include <mutex>
+#include <vector>
+
+/// List of the files written by each thread in the shard output mode of RunAction.
+///
+/// Workers write their ntuples to their own files instead of merging them into the file of the master.
+/// Each worker adds its shard at the end of the run, and the master writes the manifest,
+/// one line per shard with its file, thread, number of events and first and last event ids.
+/// Events are dealt to workers in bunches, so the events of a shard are not consecutive in general.
+/// Read() gives the shard files to be chained, as StepTreeReader does for a manifest given as input.
+class ShardManifest
+{
+    public:
+    struct Shard
+    {
+        G4String fileName;
+        G4int threadId = -1;
+        G4int nbOfEvents = 0;
+        // -1 if the shard has no event
+        G4int firstEventId = -1, lastEventId = -1;
+    };
+
+    public:
+    static ShardManifest *GetInstance();
+
+    void Clear();
+    // called by each worker, thread-safe
+    void AddShard(const Shard &shard);
+    // Write the manifest with the shards in the order of threads.
+    // Shard files in the directory of the manifest are listed by their names relative to it.
+    void Write(const G4String &fileName);
+
+    // Shards listed in a manifest. Relative file names are taken relative to the directory of the manifest.
+    static std::vector<Shard> Read(const G4String &fileName);
+    // whether a file name is that of a manifest, rather than of a ROOT file
+    static G4bool IsManifest(const G4String &fileName);
+
+    private:
+    ShardManifest();
+    ~ShardManifest();
+
+    private:
+    std::mutex fMutex;
+    std::vector<Shard> fShards;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
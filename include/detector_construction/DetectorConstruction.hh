@@ -56,6 +56,10 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     
     void SetVisAttributes();
 
+    // construct the RecorderSD of an ancillary detector enabled in parameters/ancillary.txt
+    template<typename Traits>
+    void ConstructRecorderSD();
+
     void RegisterGasMat(const G4String &key, const G4String &val);
     G4Material *FindGasMat(const G4String &key);
     G4String GetGasMixtureStat();
@@ -0,0 +1,48 @@
+/// \file AvalancheGain.hh
+/// \brief Definition of the AvalancheGain class
+
+#ifndef AvalancheGain_h
+#define AvalancheGain_h 1
+
+#include "digitizer/DigitizerEvent.hh"
+#include "digitizer/PolyaGainTable.hh"
+#include "config/ParamContainer.hh"
+
+#include "Randomize.hh"
+
+#include <memory>
+#include <vector>
+
+/// Digitizer stage amplifying the charge of pads by the avalanche in Micromegas or GEM.
+///
+/// Every electron collected by a pad is amplified by its own gain, drawn from the PolyaGainTable
+/// of polyaTheta and scaled by the mean gain. Uniform numbers of a pad are drawn in one batch,
+/// and the gains of its electrons are summed in one loop over the table.
+/// In the cluster mode, the fractional charge of a pad is randomly rounded to a number of electrons.
+/// The charge of pads becomes the amplified charge, and waveforms, made from the collected electrons,
+/// are scaled by the gain of their pad.
+class AvalancheGain
+{
+    public:
+    AvalancheGain(const ParamContainer *params);
+    virtual ~AvalancheGain();
+
+    // Amplify the charge of pads, and give the gain of each pad to padGains.
+    void Amplify(PadCharges &padCharges, std::vector<G4double> &padGains, CLHEP::HepRandomEngine &engine);
+    void ScaleWaveforms(const std::vector<G4double> &padGains, PadWaveforms &waveforms) const;
+
+    // mean gain, changed by the transport table of the gas if any
+    void SetMeanGain(G4double gain) { fMeanGain = gain; }
+    G4double GetMeanGain() const { return fMeanGain; }
+
+    private:
+    G4double fMeanGain;
+    // shared by all threads
+    std::shared_ptr<const PolyaGainTable> fTable;
+    // uniform numbers of a pad
+    std::vector<G4double> fUniforms;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
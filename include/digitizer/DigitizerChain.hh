@@ -0,0 +1,72 @@
+/// \file DigitizerChain.hh
+/// \brief Definition of the DigitizerChain class
+
+#ifndef DigitizerChain_h
+#define DigitizerChain_h 1
+
+#include "digitizer/AvalancheGain.hh"
+#include "digitizer/DigitizerEvent.hh"
+#include "digitizer/ElectronDrift.hh"
+#include "digitizer/PadPlane.hh"
+#include "digitizer/PadResponse.hh"
+#include "digitizer/WaveformGenerator.hh"
+#include "digitizer/WaveformReadout.hh"
+#include "config/ParamContainer.hh"
+
+#include "Randomize.hh"
+
+/// Chain of the digitizer stages, from energy deposits to the readout.
+///
+/// It depends neither on Geant4 events nor on hits, so that it can be run by the simulation
+/// and by a standalone program on stored steps. One chain is owned by each thread,
+/// and all random numbers are drawn from the engine given to Process().
+/// Gaussian numbers are drawn by RandGaussQ, which keeps no spare number between events unlike RandGauss,
+/// so that an event depends only on the state of the engine, whatever thread processed the previous events.
+/// In the electron mode every drifted electron is collected by the pad containing it,
+/// and in the cluster mode the charge cloud of each step is integrated over the pads by PadResponse.
+/// The collected charge is amplified by AvalancheGain if gain is positive.
+/// Waveforms of the pads with signal are made by WaveformGenerator if waveform is set,
+/// and WaveformReadout adds noise to them and selects the samples read out.
+class DigitizerChain
+{
+    public:
+    enum Mode
+    {
+        kElectron, kCluster
+    };
+
+    public:
+    DigitizerChain(const ParamContainer *params, const ParamContainer *padPlaneParams);
+    virtual ~DigitizerChain();
+
+    // Prepare the buffers of an event for this chain, once before its first use.
+    void InitEvent(DigitizerEvent &event) const;
+    // process the steps of an event into the other buffers of the event.
+    void Process(DigitizerEvent &event, CLHEP::HepRandomEngine &engine);
+
+    ElectronDrift *GetElectronDrift() const { return fElectronDrift; }
+    const PadPlane *GetPadPlane() const { return fPadPlane; }
+    // null if the charge is not amplified
+    AvalancheGain *GetAvalancheGain() const { return fAvalancheGain; }
+    // null if waveforms are not made
+    const WaveformGenerator *GetWaveformGenerator() const { return fWaveformGenerator; }
+    const WaveformReadout *GetWaveformReadout() const { return fWaveformReadout; }
+    Mode GetMode() const { return fMode; }
+
+    private:
+    // collect drifted electrons by the pads containing them.
+    void CollectElectrons(DigitizerEvent &event) const;
+
+    private:
+    Mode fMode;
+    ElectronDrift *fElectronDrift;
+    PadPlane *fPadPlane;
+    PadResponse *fPadResponse;
+    AvalancheGain *fAvalancheGain;
+    WaveformGenerator *fWaveformGenerator;
+    WaveformReadout *fWaveformReadout;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,81 @@
+/// \file DigitizerColumns.hh
+/// \brief Definition of the DigitizerColumns class
+
+#ifndef DigitizerColumns_h
+#define DigitizerColumns_h 1
+
+#include "digitizer/DigitizerEvent.hh"
+#include "digitizer/SparseWaveforms.hh"
+#include "config/ParamContainer.hh"
+
+#include <vector>
+
+/// Trees of the digitizer output and their columns, shared by DigitizerNtuple and RedigitizeOutput
+/// so that both outputs have the same columns, filled alike.
+///
+/// tree_drift : drifted electrons at the pad plane, one row per event, if writeElectrons is set (empty in the cluster mode).
+/// tree_pad : number of electrons collected by each pad with signal, one row per event, if writePadCharge is set.
+/// tree_wave : samples read out of the waveforms, one row per event, if writeWaveforms is set.
+/// The samples of pad[i] are nSample[i] consecutive values of adc, at the time buckets of bucket
+/// in the zero suppression mode and from the first bucket in the other modes.
+/// tree_sparse : the samples of tree_wave in the sparse pad-time layout of SparseWaveforms,
+/// one row per event, if writeSparse is set.
+/// Columns are bound to buffers of this class, which writers book as ntuple columns or branches.
+class DigitizerColumns
+{
+    public:
+    struct Column
+    {
+        enum Type
+        {
+            kInt, kIntVector, kFloatVector
+        };
+        G4String name;
+        Type type;
+        G4int *value;
+        std::vector<G4int> *ints;
+        std::vector<G4float> *floats;
+    };
+
+    struct Tree
+    {
+        G4String name, title;
+        std::vector<Column> columns;
+    };
+
+    public:
+    DigitizerColumns(const ParamContainer *params);
+    virtual ~DigitizerColumns();
+    // columns point to the buffers of this object.
+    DigitizerColumns(const DigitizerColumns &) = delete;
+    DigitizerColumns &operator=(const DigitizerColumns &) = delete;
+
+    // trees written with the flags of the parameters, in the order of the list above
+    const std::vector<Tree> &GetTrees() const { return fTrees; }
+    // Fill the buffers of all trees with an event.
+    void Fill(const DigitizerEvent &event);
+
+    private:
+    static Column IntColumn(const G4String &name, G4int *value) { return {name, Column::kInt, value, nullptr, nullptr}; }
+    static Column IntColumn(const G4String &name, std::vector<G4int> *values)
+    { return {name, Column::kIntVector, nullptr, values, nullptr}; }
+    static Column FloatColumn(const G4String &name, std::vector<G4float> *values)
+    { return {name, Column::kFloatVector, nullptr, nullptr, values}; }
+
+    private:
+    G4bool fWriteElectrons, fWritePadCharge, fWriteWaveforms, fWriteSparse, fWriteBuckets;
+    std::vector<Tree> fTrees;
+    // buffers bound to the columns
+    G4int fEventId, fNbOfElectrons, fNbOfPads, fNbOfReadoutPads, fNbOfSparsePads;
+    std::vector<G4float> fElectronX, fElectronY, fElectronT;
+    std::vector<G4int> fElectronPad;
+    std::vector<G4int> fPads;
+    std::vector<G4float> fPadCharge;
+    std::vector<G4int> fReadoutPads, fReadoutNbOfSamples, fReadoutBuckets;
+    std::vector<G4float> fReadoutSamples;
+    SparseWaveforms fSparse;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
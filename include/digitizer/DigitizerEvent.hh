@@ -0,0 +1,156 @@
+/// \file DigitizerEvent.hh
+/// \brief Definition of the DigitizerEvent struct
+
+#ifndef DigitizerEvent_h
+#define DigitizerEvent_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Energy deposits of an event given to the digitizer, in Geant4 units.
+struct DigitizerSteps
+{
+    std::vector<G4double> x, y, z, eDep, t;
+
+    void Clear() { x.clear(); y.clear(); z.clear(); eDep.clear(); t.clear(); }
+    G4int Size() const { return eDep.size(); }
+    void Append(G4double xx, G4double yy, G4double zz, G4double edep, G4double tt)
+    { x.push_back(xx); y.push_back(yy); z.push_back(zz); eDep.push_back(edep); t.push_back(tt); }
+};
+
+/// Ionization electrons at their arrival on the pad plane, and their pads (-1 if none).
+struct DriftElectrons
+{
+    std::vector<G4double> x, y, t;
+    std::vector<G4int> pad;
+
+    void Clear() { x.clear(); y.clear(); t.clear(); pad.clear(); }
+    G4int Size() const { return t.size(); }
+    void Resize(G4int n) { x.resize(n); y.resize(n); t.resize(n); pad.resize(n); }
+};
+
+/// Charge clouds of steps at their arrival on the pad plane, gaussian with their transverse
+/// sigma and time sigma, for the cluster mode of the digitizer.
+struct ChargeClusters
+{
+    std::vector<G4double> x, y, t, sigma, sigmaTime, charge;
+
+    void Clear() { x.clear(); y.clear(); t.clear(); sigma.clear(); sigmaTime.clear(); charge.clear(); }
+    G4int Size() const { return charge.size(); }
+    void Resize(G4int n)
+    { x.resize(n); y.resize(n); t.resize(n); sigma.resize(n); sigmaTime.resize(n); charge.resize(n); }
+};
+
+/// Charge collected by the pads with signal, in the order of their first signal.
+struct PadCharges
+{
+    std::vector<G4int> pads;
+    std::vector<G4double> charge;
+    // index in pads of every pad of the pad plane, -1 if no signal
+    std::vector<G4int> indexOfPad;
+
+    void Init(G4int nbOfPads) { indexOfPad.assign(nbOfPads, -1); }
+    // Clear only the pads with signal, so that the cost does not depend on the number of pads.
+    void Clear()
+    {
+        for(auto pad : pads)
+            indexOfPad[pad] = -1;
+        pads.clear();
+        charge.clear();
+    }
+    G4int Size() const { return pads.size(); }
+    // index of a pad in pads, added if not there yet.
+    G4int GetIndex(G4int pad)
+    {
+        G4int &index = indexOfPad[pad];
+        if(index < 0)
+        {
+            index = pads.size();
+            pads.push_back(pad);
+            charge.push_back(0.);
+        }
+        return index;
+    }
+    void Add(G4int pad, G4double q) { charge[GetIndex(pad)] += q; }
+};
+
+/// Charge given to pads by clusters in the cluster mode, with the index of the pad in PadCharges.
+struct ClusterSignals
+{
+    std::vector<G4int> cluster, padIndex;
+    std::vector<G4double> charge;
+
+    void Clear() { cluster.clear(); padIndex.clear(); charge.clear(); }
+    G4int Size() const { return charge.size(); }
+    void Append(G4int c, G4int index, G4double q) { cluster.push_back(c); padIndex.push_back(index); charge.push_back(q); }
+};
+
+/// Waveforms of the pads with signal, of nbOfBuckets samples each.
+/// The waveform of PadCharges::pads[i] starts at samples[i*nbOfBuckets].
+struct PadWaveforms
+{
+    G4int nbOfBuckets = 0;
+    std::vector<G4float> samples;
+
+    void Clear() { samples.clear(); }
+    G4int Size() const { return nbOfBuckets > 0 ? samples.size()/nbOfBuckets : 0; }
+    G4float *GetWaveform(G4int index) { return samples.data() + index*nbOfBuckets; }
+    const G4float *GetWaveform(G4int index) const { return samples.data() + index*nbOfBuckets; }
+};
+
+/// Samples read out after noise, threshold and zero suppression.
+/// Samples of pads[i] are samples[first[i]] to samples[first[i + 1] - 1] at time buckets buckets[].
+struct ReadoutSamples
+{
+    std::vector<G4int> pads, buckets;
+    std::vector<G4int> first = std::vector<G4int>(1, 0);
+    std::vector<G4float> samples;
+
+    void Clear() { pads.clear(); first.assign(1, 0); buckets.clear(); samples.clear(); }
+    G4int Size() const { return pads.size(); }
+    G4int GetNbOfSamples(G4int i) const { return first[i + 1] - first[i]; }
+    void Append(G4int bucket, G4float sample) { buckets.push_back(bucket); samples.push_back(sample); }
+    // close the samples of a pad, or drop them if there is none.
+    void ClosePad(G4int pad)
+    {
+        if(static_cast<G4int>(samples.size()) == first.back())
+            return;
+        pads.push_back(pad);
+        first.push_back(samples.size());
+    }
+};
+
+/// Buffers of all digitizer stages for an event.
+///
+/// An instance is reused by every event of a thread, so the buffers keep their capacity.
+struct DigitizerEvent
+{
+    G4int eventId = -1;
+    DigitizerSteps steps;
+    DriftElectrons electrons;
+    ChargeClusters clusters;
+    ClusterSignals clusterSignals;
+    PadCharges padCharges;
+    // gain of the pads with signal, aligned with padCharges.pads, if the charge is amplified
+    std::vector<G4double> padGains;
+    PadWaveforms waveforms;
+    ReadoutSamples readout;
+
+    void Clear()
+    {
+        eventId = -1;
+        steps.Clear();
+        electrons.Clear();
+        clusters.Clear();
+        clusterSignals.Clear();
+        padCharges.Clear();
+        padGains.clear();
+        waveforms.Clear();
+        readout.Clear();
+    }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,33 @@
+/// \file DigitizerNtuple.hh
+/// \brief Definition of the DigitizerNtuple class
+
+#ifndef DigitizerNtuple_h
+#define DigitizerNtuple_h 1
+
+#include "digitizer/DigitizerColumns.hh"
+#include "digitizer/DigitizerEvent.hh"
+#include "config/ParamContainer.hh"
+
+#include <vector>
+
+/// Ntuple of the digitizer output, booked by RunAction and filled by EventAction.
+///
+/// The ntuples are the trees of DigitizerColumns, booked with the analysis manager.
+class DigitizerNtuple
+{
+    public:
+    DigitizerNtuple(const ParamContainer *params);
+    virtual ~DigitizerNtuple();
+
+    void Book();
+    void Fill(const DigitizerEvent &event);
+
+    private:
+    DigitizerColumns fColumns;
+    // ntuple id of each tree of fColumns
+    std::vector<G4int> fNtupleIds;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
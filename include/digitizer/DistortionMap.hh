@@ -0,0 +1,44 @@
+/// \file DistortionMap.hh
+/// \brief Definition of the DistortionMap class
+
+#ifndef DistortionMap_h
+#define DistortionMap_h 1
+
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
+
+/// Displacement of drifting electrons by field distortions (ExB, space charge), on a regular 3D grid.
+///
+/// The map gives the displacement (dx, dy) of the arrival point on the pad plane of electrons
+/// starting from a point of the chamber, and the change dz of their drift length,
+/// which the drift stage converts into a time shift.
+/// The text file starts with "nx ny nz x0 y0 z0 stepX stepY stepZ" for the grid, followed by nx*ny*nz
+/// lines "dx dy dz" with x running fastest, all in mm.
+/// Displacements of a node are stored together in one contiguous array, so trilinear interpolation
+/// reads eight nearby triplets. Points outside the grid take the value at the nearest boundary.
+/// Maps are loaded once by Load() and shared read-only by all threads.
+class DistortionMap
+{
+    public:
+    // map of a file, loaded by the first call and shared afterwards, null if it cannot be read.
+    static std::shared_ptr<const DistortionMap> Load(const G4String &fileName);
+
+    DistortionMap();
+    virtual ~DistortionMap();
+
+    G4bool ReadText(const G4String &fileName);
+    // displacement at (x, y, z), written to d[3]
+    void Interpolate(G4double x, G4double y, G4double z, G4double *d) const;
+
+    private:
+    G4int fNbOfNodes[3];
+    G4double fOrigin[3], fStep[3];
+    // dx dy dz of node (ix, iy, iz) at 3*((iz*ny + iy)*nx + ix)
+    std::vector<G4float> fDisplacements;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
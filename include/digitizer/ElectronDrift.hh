@@ -0,0 +1,72 @@
+/// \file ElectronDrift.hh
+/// \brief Definition of the ElectronDrift class
+
+#ifndef ElectronDrift_h
+#define ElectronDrift_h 1
+
+#include "digitizer/DigitizerEvent.hh"
+#include "digitizer/DistortionMap.hh"
+#include "config/ParamContainer.hh"
+
+#include "Randomize.hh"
+
+#include <memory>
+#include <vector>
+
+/// Digitizer stage converting energy deposits into ionization electrons
+/// and drifting them to the pad plane with diffusion.
+///
+/// Electrons drift along z to the pad plane at padPlaneZ with a constant drift velocity.
+/// The number of electrons of a step is sampled with the Fano factor from eDep/W,
+/// binomially below 20 electrons and as a gaussian above,
+/// and electrons are spread by sigma = D*sqrt(drift length) transversely and longitudinally.
+/// Gaussian numbers of all electrons of an event are drawn in one batch,
+/// so that the transport loops have no call into the random engine and can be vectorized.
+/// DriftClusters() only samples the number of electrons of steps and gives the sigma of their clouds.
+/// If distortionMap is given, the start point of every step is displaced by the DistortionMap;
+/// otherwise the map is never looked up.
+class ElectronDrift
+{
+    public:
+    ElectronDrift(const ParamContainer *params);
+    virtual ~ElectronDrift();
+
+    void Drift(const DigitizerSteps &steps, DriftElectrons &electrons, CLHEP::HepRandomEngine &engine);
+    // Drift the electrons of each step as one gaussian cloud, without sampling every electron.
+    void DriftClusters(const DigitizerSteps &steps, ChargeClusters &clusters, CLHEP::HepRandomEngine &engine);
+
+    // mean energy per ion pair of the gas
+    void SetMeanEnergyPerIonPair(G4double w) { fMeanEnergyPerIonPair = w; }
+    G4double GetMeanEnergyPerIonPair() const { return fMeanEnergyPerIonPair; }
+    // transport properties, changed by the transport table of the gas if any
+    void SetDriftVelocity(G4double velocity) { fDriftVelocity = velocity; }
+    void SetDiffusion(G4double diffusionL, G4double diffusionT) { fDiffusionL = diffusionL; fDiffusionT = diffusionT; }
+    G4double GetDriftVelocity() const { return fDriftVelocity; }
+    G4double GetDiffusionL() const { return fDiffusionL; }
+    G4double GetDiffusionT() const { return fDiffusionT; }
+    G4double GetPadPlaneZ() const { return fPadPlaneZ; }
+
+    private:
+    G4int SampleNbOfElectrons(G4double meanNbOfElectrons, CLHEP::HepRandomEngine &engine) const;
+    G4bool CheckMeanEnergyPerIonPair() const;
+    // arrival point and time on the pad plane of the center of a step
+    void GetArrival(const DigitizerSteps &steps, G4int i, G4double &x, G4double &y, G4double &t) const;
+
+    private:
+    G4double fMeanEnergyPerIonPair;
+    G4double fFanoFactor;
+    G4double fDriftVelocity;
+    // sigma per square root of drift length
+    G4double fDiffusionL, fDiffusionT;
+    G4double fPadPlaneZ;
+    // shared by all threads, null if no distortion
+    std::shared_ptr<const DistortionMap> fDistortionMap;
+
+    // scratch buffers reused by events
+    std::vector<G4int> fNbOfElectrons;
+    std::vector<G4double> fGaussians;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,51 @@
+/// \file GasChamberDigitizer.hh
+/// \brief Definition of the GasChamberDigitizer class
+
+#ifndef GasChamberDigitizer_h
+#define GasChamberDigitizer_h 1
+
+#include "G4VDigitizerModule.hh"
+
+#include "digitizer/DigitizerChain.hh"
+#include "digitizer/DigitizerEvent.hh"
+#include "digitizer/GasTransportTable.hh"
+
+/// Digitizer module of the gas chamber, run at the end of event by EventAction.
+///
+/// It takes the step points of the hits of GasChamberSD and runs the DigitizerChain
+/// configured by parameters/digitizer.txt with the random engine of the thread.
+/// The step columns x, y, z and eDep must be recorded, and t is taken as zero if it is not.
+/// With useTransportTable, the drift velocity and diffusion are interpolated at driftField
+/// in the transport table of the current gas mixture, taken from GasTransportStore when the gas changes.
+/// Those of parameters/digitizer.txt are used for mixtures without a table.
+/// The W-value of the gas is that of the mixture selected in GasTransportStore with its table.
+class GasChamberDigitizer : public G4VDigitizerModule
+{
+    public:
+    GasChamberDigitizer(G4String name = "GasChamberDigitizer");
+    virtual ~GasChamberDigitizer();
+
+    virtual void Digitize();
+
+    const DigitizerEvent &GetEvent() const { return fEvent; }
+
+    private:
+    void FillSteps();
+    // Take the W-value and the transport properties of the gas mixture if it has changed since the last event.
+    void UpdateGas();
+
+    private:
+    DigitizerChain *fChain;
+    DigitizerEvent fEvent;
+    G4int fGasChamberHcId;
+    G4bool fUseGasW;
+    G4bool fUseTransportTable;
+    G4double fDriftField;
+    // transport properties of the parameters, for mixtures without a table
+    GasTransport fParamTransport;
+    G4int fGasGeneration;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
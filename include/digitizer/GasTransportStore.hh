@@ -0,0 +1,59 @@
+/// \file GasTransportStore.hh
+/// \brief Definition of the GasTransportStore class
+
+#ifndef GasTransportStore_h
+#define GasTransportStore_h 1
+
+#include "digitizer/GasTransportTable.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/// Cache of the transport tables of gas mixtures, shared by all threads.
+///
+/// DetectorConstruction::SetGas() selects the mixture of the chamber. The table of a mixture is
+/// keyed by its (gas1, frac1, gas2, frac2, pressure) tuple, e.g. He_90_iC4H10_10_0.10atm,
+/// and is loaded once from transportDir/<key>.txt, or from the binary cache in transportCacheDir
+/// if it was made from the same text file. Loaded tables stay in memory, so changing back to
+/// a mixture costs nothing. Digitizers poll GetGeneration() and take the current table when it changes.
+/// The mean energy per ion pair of the mixture is selected with it, so that digitizers take the W-value
+/// and the table of the same mixture, whether tables are used or not.
+class GasTransportStore
+{
+    public:
+    static GasTransportStore *GetInstance();
+
+    static G4String MakeKey(const G4String &gas1, G4double frac1, const G4String &gas2, G4double frac2, G4double pressure);
+
+    // Select the mixture of the chamber, the current table is null if it has no table or tables are not used.
+    void SelectMixture(const G4String &gas1, G4double frac1, const G4String &gas2, G4double frac2, G4double pressure,
+        G4double meanEnergyPerIonPair);
+    std::shared_ptr<const GasTransportTable> GetCurrentTable() const;
+    // zero if no mixture is selected or the W-values of its gases are unknown
+    G4double GetCurrentMeanEnergyPerIonPair() const;
+    // incremented whenever the mixture is selected
+    G4int GetGeneration() const { return fGeneration.load(std::memory_order_acquire); }
+    G4bool IsEnabled() const { return fEnabled; }
+
+    private:
+    GasTransportStore();
+    ~GasTransportStore();
+
+    std::shared_ptr<const GasTransportTable> Load(const G4String &key) const;
+
+    private:
+    G4bool fEnabled;
+    G4String fTransportDir, fCacheDir;
+    mutable std::mutex fMutex;
+    std::unordered_map<std::string, std::shared_ptr<const GasTransportTable>> fTables;
+    std::shared_ptr<const GasTransportTable> fCurrentTable;
+    G4double fCurrentMeanEnergyPerIonPair;
+    std::atomic<G4int> fGeneration;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,47 @@
+/// \file GasTransportTable.hh
+/// \brief Definition of the GasTransportTable class
+
+#ifndef GasTransportTable_h
+#define GasTransportTable_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Transport properties of electrons in a gas at an electric field, in Geant4 units.
+struct GasTransport
+{
+    G4double driftVelocity;
+    // sigma per square root of drift length
+    G4double diffusionL, diffusionT;
+    // mean gain of the amplification
+    G4double gain;
+};
+
+/// Transport properties of a gas mixture tabulated against the electric field.
+///
+/// The text file has lines "E vDrift DL DT gain" in V/cm, cm/us, sqrt(cm), sqrt(cm) and gain,
+/// as exported from Magboltz or Garfield++, with comments after '#'.
+/// Columns are kept in contiguous arrays sorted by field, and Interpolate() is linear between points
+/// and constant outside the table. The binary file is a cache of the arrays, written and read as they are.
+class GasTransportTable
+{
+    public:
+    GasTransportTable();
+    virtual ~GasTransportTable();
+
+    G4bool ReadText(const G4String &fileName);
+    // The binary file is valid only if it was made from a source file of the given stamp.
+    G4bool ReadBinary(const G4String &fileName, G4long sourceStamp);
+    G4bool WriteBinary(const G4String &fileName, G4long sourceStamp) const;
+
+    GasTransport Interpolate(G4double field) const;
+    G4int GetNbOfPoints() const { return fField.size(); }
+
+    private:
+    std::vector<G4double> fField, fDriftVelocity, fDiffusionL, fDiffusionT, fGain;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
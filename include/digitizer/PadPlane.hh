@@ -0,0 +1,68 @@
+/// \file PadPlane.hh
+/// \brief Definition of the PadPlane class
+
+#ifndef PadPlane_h
+#define PadPlane_h 1
+
+#include "config/ParamContainer.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Geometry of the pad plane in the x-y plane, perpendicular to the drift.
+///
+/// Pads are convex polygons of up to six vertices, generated as a triangular or hexagonal
+/// tessellation of a disk, or given vertex by vertex, by parameters/pad_plane.txt.
+/// A uniform grid of cells over the plane lists the pads whose bounding box overlaps each cell,
+/// so that FindPad() tests only a few pads whatever the number of pads is.
+class PadPlane
+{
+    public:
+    PadPlane(const ParamContainer *params);
+    virtual ~PadPlane();
+
+    // pad containing the point, -1 if none.
+    G4int FindPad(G4double x, G4double y) const;
+    // pads of n points
+    void FindPads(const G4double *x, const G4double *y, G4int n, G4int *pads) const;
+
+    G4int GetNbOfPads() const { return fNbOfVertices.size(); }
+    G4int GetNbOfVertices(G4int pad) const { return fNbOfVertices[pad]; }
+    G4double GetVertexX(G4int pad, G4int i) const { return fVertexX[kMaxNbOfVertices*pad + i]; }
+    G4double GetVertexY(G4int pad, G4int i) const { return fVertexY[kMaxNbOfVertices*pad + i]; }
+    G4double GetCenterX(G4int pad) const { return fCenterX[pad]; }
+    G4double GetCenterY(G4int pad) const { return fCenterY[pad]; }
+    // cells of the lookup grid and the pads listed in a cell
+    G4int GetCell(G4double x, G4double y) const;
+    G4int GetNbOfCellsX() const { return fNbOfCellsX; }
+    // Range of cells {x first, x last, y first, y last} overlapped by a box, false if none.
+    G4bool GetCellRange(G4double xMin, G4double xMax, G4double yMin, G4double yMax, G4int *range) const;
+    G4int GetNbOfCellPads(G4int cell) const { return fCellStart[cell + 1] - fCellStart[cell]; }
+    const G4int *GetCellPads(G4int cell) const { return fCellPads.data() + fCellStart[cell]; }
+
+    static constexpr G4int kMaxNbOfVertices = 6;
+
+    private:
+    void AddPad(const G4double *x, const G4double *y, G4int nbOfVertices);
+    void GenerateTriangular(G4double radius, G4double side);
+    void GenerateHexagonal(G4double radius, G4double side);
+    void BuildLookupGrid(G4double cellSize);
+    G4bool IsInside(G4int pad, G4double x, G4double y) const;
+
+    private:
+    G4double fCenterX0, fCenterY0;
+    // vertices of pads in counterclockwise order, kMaxNbOfVertices per pad
+    std::vector<G4double> fVertexX, fVertexY;
+    std::vector<G4int> fNbOfVertices;
+    std::vector<G4double> fCenterX, fCenterY;
+
+    // lookup grid, pads of cell i are fCellPads[fCellStart[i]] to fCellPads[fCellStart[i + 1] - 1]
+    G4double fGridX0, fGridY0, fCellSize;
+    G4int fNbOfCellsX, fNbOfCellsY;
+    std::vector<G4int> fCellStart;
+    std::vector<G4int> fCellPads;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,56 @@
+/// \file PadResponse.hh
+/// \brief Definition of the PadResponse class
+
+#ifndef PadResponse_h
+#define PadResponse_h 1
+
+#include "digitizer/DigitizerEvent.hh"
+#include "digitizer/PadPlane.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Collection of gaussian charge clouds by the pads of a PadPlane, for the cluster mode of the digitizer.
+///
+/// The fraction of a cloud on a pad is integrated analytically as the signed sum over the edges of
+/// the pad of the integrals over the triangles made by the center of the cloud and the edges.
+/// In polar coordinates around the center, the integral over such a triangle is
+/// (phi2 - phi1)/2pi - G(d, phi2) + G(d, phi1), where d is the distance to the edge and phi are
+/// the angles of its vertices from the normal to the edge, both in units of sigma,
+/// and G(d, phi) = 1/2pi int_0^phi exp(-d^2/2cos^2(psi)) dpsi is the Owen's T function T(d, tan(phi)).
+/// The angle terms add up to one if the center is inside the pad and to zero otherwise.
+/// G is interpolated in a table computed once and shared by all threads,
+/// and only pads whose bounding box is within cloudRange sigma of the center are integrated.
+class PadResponse
+{
+    public:
+    PadResponse(const PadPlane *padPlane, G4double cloudRange);
+    virtual ~PadResponse();
+
+    // Add the charge of clusters to the pads overlapped by them,
+    // and the charge given by each cluster to each pad to signals if not null.
+    void Collect(const ChargeClusters &clusters, PadCharges &padCharges, ClusterSignals *signals = nullptr);
+    // fraction of a gaussian cloud centered at (x0, y0) on a pad
+    G4double Integrate(G4int pad, G4double x0, G4double y0, G4double sigma) const;
+
+    // Owen's T function T(d, tan(phi)) from the table, with w = tan(phi)/(1 + |tan(phi)|)
+    static G4double OwensT(G4double d, G4double w);
+
+    private:
+    void AddCharge(G4int cluster, G4int pad, G4double charge, PadCharges &padCharges, ClusterSignals *signals) const;
+
+    private:
+    const PadPlane *fPadPlane;
+    G4double fCloudRange;
+    // a cloud below this sigma is collected by the pad containing its center.
+    G4double fMinSigma;
+    // bounding boxes of pads
+    std::vector<G4double> fPadMinX, fPadMaxX, fPadMinY, fPadMaxY;
+    // pads already visited by the current cloud, which may be listed in several cells
+    std::vector<G4int> fVisited;
+    G4int fVisitId;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
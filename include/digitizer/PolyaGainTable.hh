@@ -0,0 +1,65 @@
+/// \file PolyaGainTable.hh
+/// \brief Definition of the PolyaGainTable class
+
+#ifndef PolyaGainTable_h
+#define PolyaGainTable_h 1
+
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
+
+/// Walker alias table of the Polya distribution of the avalanche gain of single electrons.
+///
+/// The gain relative to the mean gain has the density (1 + theta)^(1 + theta)/Gamma(1 + theta)
+/// x^theta exp(-(1 + theta)x), theta = 0 being the exponential distribution.
+/// It is tabulated in kNbOfBins bins of equal width up to where the tail is negligible,
+/// and a draw is uniform in its bin. One uniform number makes one draw: its integer part
+/// over the bins selects a bin, and its fractional part chooses between the bin and its alias
+/// and gives the position in the bin, so sampling costs no more than a table lookup.
+/// Tables are built once per theta by Get() and shared read-only by all threads.
+class PolyaGainTable
+{
+    public:
+    static constexpr G4int kNbOfBins = 4096;
+
+    public:
+    // table of theta, built by the first call and shared afterwards
+    static std::shared_ptr<const PolyaGainTable> Get(G4double theta);
+
+    PolyaGainTable(G4double theta);
+    virtual ~PolyaGainTable();
+
+    // relative gain of a uniform number in [0, 1)
+    G4double Sample(G4double u) const
+    {
+        const G4double r = u*kNbOfBins;
+        G4int bin = static_cast<G4int>(r);
+        if(bin >= kNbOfBins)
+            bin = kNbOfBins - 1;
+        const G4double f = r - bin;
+        const G4double p = fProbability[bin];
+        if(f < p)
+            return (bin + f/p)*fBinWidth;
+        return (fAlias[bin] + (f - p)/(1. - p))*fBinWidth;
+    }
+    // sum of the relative gains of n uniform numbers
+    G4double SampleSum(const G4double *u, G4int n) const;
+    G4double GetTheta() const { return fTheta; }
+
+    private:
+    // regularized lower incomplete gamma function P(a, x)
+    static G4double IncompleteGamma(G4double a, G4double x);
+    void BuildAliases(std::vector<G4double> &mass);
+
+    private:
+    G4double fTheta;
+    G4double fBinWidth;
+    // probability of keeping a bin instead of its alias
+    std::vector<G4double> fProbability;
+    std::vector<G4int> fAlias;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,34 @@
+/// \file SparseWaveforms.hh
+/// \brief Definition of the SparseWaveforms struct
+
+#ifndef SparseWaveforms_h
+#define SparseWaveforms_h 1
+
+#include "digitizer/DigitizerEvent.hh"
+
+#include <vector>
+
+/// Sparse pad-time layout of the readout samples of an event, written to tree_sparse.
+///
+/// Pads are sorted by pad id, and the samples kept by WaveformReadout in its readout mode are stored
+/// as runs of consecutive buckets, so that the layout holds the same samples as tree_wave.
+/// Pad pads[i] has nbOfRanges[i] runs, and run j starts at bucket rangeStart[j] with rangeLength[j]
+/// samples. Runs of all pads follow one another, and so do their samples in samples.
+/// A pad has one run of all buckets in the full and partial modes, and runs of samples above its threshold
+/// in the zero suppression mode, where the size of an event scales with the number of samples above threshold.
+/// rmacros/SparseWaveformReader.h reads this layout back.
+struct SparseWaveforms
+{
+    std::vector<G4int> pads, nbOfRanges, rangeStart, rangeLength;
+    std::vector<G4float> samples;
+    // readout pads sorted by pad id, kept for the next event
+    std::vector<G4int> order;
+
+    void Clear() { pads.clear(); nbOfRanges.clear(); rangeStart.clear(); rangeLength.clear(); samples.clear(); }
+    G4int Size() const { return pads.size(); }
+    void Encode(const ReadoutSamples &readout);
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,54 @@
+/// \file WaveformGenerator.hh
+/// \brief Definition of the WaveformGenerator class
+
+#ifndef WaveformGenerator_h
+#define WaveformGenerator_h 1
+
+#include "digitizer/DigitizerEvent.hh"
+#include "config/ParamContainer.hh"
+
+#include <vector>
+
+/// Digitizer stage making the sampled waveforms of the pads with signal, as recorded by GET electronics.
+///
+/// Arrival times are binned into nbOfTimeBuckets buckets of 1/samplingFrequency from triggerDelay,
+/// and the binned charge is convolved with the shaping response of the preamplifier.
+/// The response, "aget" for exp(-3x)x^3sin(x) of the AGET chip or "crrc" for the semi-gaussian
+/// x^n exp(-x) of CR-RC^n shaping with x = t/tau, is scaled to peak at peakingTime with unit height,
+/// so waveforms are in units of electrons. It is sampled once into a kernel in the constructor.
+/// Binned charge is sparse in time, so the convolution adds the kernel scaled by the charge
+/// of every bucket with charge, which is a contiguous loop vectorized by the compiler.
+class WaveformGenerator
+{
+    public:
+    WaveformGenerator(const ParamContainer *params);
+    virtual ~WaveformGenerator();
+
+    // waveforms of the pads with signal of an event, from its electrons or its cluster signals.
+    void Generate(DigitizerEvent &event);
+
+    G4int GetNbOfTimeBuckets() const { return fNbOfTimeBuckets; }
+    G4double GetBucketWidth() const { return fBucketWidth; }
+    const std::vector<G4float> &GetKernel() const { return fKernel; }
+
+    private:
+    void BuildKernel(const G4String &shaping, G4double peakingTime, G4int order);
+    void BinElectrons(const DriftElectrons &electrons, const PadCharges &padCharges);
+    void BinClusters(const ChargeClusters &clusters, const ClusterSignals &signals);
+    void Convolve(const G4float *charge, G4float *waveform) const;
+
+    private:
+    G4int fNbOfTimeBuckets;
+    G4double fBucketWidth;
+    G4double fTriggerDelay;
+    // shaping response sampled at bucket centers
+    std::vector<G4float> fKernel;
+    // binned charge of pads with signal, laid out as the waveforms
+    std::vector<G4float> fBinnedCharge;
+    // fractions of the charge of a cluster in its buckets
+    std::vector<G4float> fTimeSpread;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,54 @@
+/// \file WaveformReadout.hh
+/// \brief Definition of the WaveformReadout class
+
+#ifndef WaveformReadout_h
+#define WaveformReadout_h 1
+
+#include "digitizer/DigitizerEvent.hh"
+#include "config/ParamContainer.hh"
+
+#include "Randomize.hh"
+
+#include <vector>
+
+/// Digitizer stage adding electronic noise to waveforms and selecting the samples read out by the DAQ.
+///
+/// White gaussian noise of noiseSigma electrons is added to every sample of the pads with signal.
+/// Pads without signal are not simulated, assuming thresholds well above the noise.
+/// readoutMode selects the samples as the GET readout modes:
+/// full reads all samples of all pads with signal, partial reads all samples of pads with
+/// a sample above their threshold, and zero reads only the samples above threshold.
+/// The threshold of a pad is threshold (electrons) unless given by thresholdFile,
+/// of lines "pad threshold".
+class WaveformReadout
+{
+    public:
+    enum Mode
+    {
+        kFull, kPartial, kZeroSuppression
+    };
+
+    public:
+    WaveformReadout(const ParamContainer *params, G4int nbOfPads);
+    virtual ~WaveformReadout();
+
+    void Read(DigitizerEvent &event, CLHEP::HepRandomEngine &engine);
+
+    Mode GetMode() const { return fMode; }
+    G4double GetThreshold(G4int pad) const { return fThresholds[pad]; }
+
+    private:
+    void ReadThresholdFile(const G4String &fileName);
+    void AddNoise(PadWaveforms &waveforms, CLHEP::HepRandomEngine &engine);
+
+    private:
+    Mode fMode;
+    G4double fNoiseSigma;
+    std::vector<G4float> fThresholds;
+    // gaussian numbers of an event
+    std::vector<G4double> fGaussians;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -4,6 +4,7 @@
 #ifndef GasChamberHit_h
 #define GasChamberHit_h 1
 
+#include <array>
 #include <vector>
 
 #include "G4DynamicParticle.hh"
@@ -11,15 +12,21 @@
 #include "G4THitsCollection.hh"
 #include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
+
+#include "gas_chamber/GasChamberStepStore.hh"
 ///
 /// It records:
 /// - the energy deposit 
+///
+/// Step data are not owned by the hit, but kept in a slot of the GasChamberStepStore
+/// of the SD, which is valid until the SD is initialized for the next event.
 
 class GasChamberHit : public G4VHit
 {
     public:
     GasChamberHit();
-    GasChamberHit(const G4DynamicParticle *pDynamic, G4int evtId, G4int trkId);
+    GasChamberHit(const G4DynamicParticle *pDynamic, G4int evtId, G4int trkId,
+        GasChamberStepStore::Slot *steps);
     GasChamberHit(const GasChamberHit &right);
     virtual ~GasChamberHit();
 
@@ -30,16 +37,17 @@ class GasChamberHit : public G4VHit
     inline void operator delete(void *aHit);
 
     virtual void Print();
-    std::vector<G4double> GetEdep() const { return fEdep; }
-    std::vector<G4double> GetTime() const { return fTime; }
-    std::vector<G4double> GetPosX() const { return fPosX; }
-    std::vector<G4double> GetPosY() const { return fPosY; }
-    std::vector<G4double> GetPosZ() const { return fPosZ; }
-    std::vector<G4double> GetMomX() const { return fMomX; }
-    std::vector<G4double> GetMomY() const { return fMomY; }
-    std::vector<G4double> GetMomZ() const { return fMomZ; }
-    std::vector<G4double> GetCharge() const {return fCharge;}
-    std::vector<G4double> GetStepLen() const {return fStepLen;}
+    // Columns stored as double. Columns stored as float or fixed point are read by GetStepValue().
+    const std::vector<G4double> &GetEdep() const { return StepColumn(GasChamberStepStore::kEdep); }
+    const std::vector<G4double> &GetTime() const { return StepColumn(GasChamberStepStore::kTime); }
+    const std::vector<G4double> &GetPosX() const { return StepColumn(GasChamberStepStore::kPosX); }
+    const std::vector<G4double> &GetPosY() const { return StepColumn(GasChamberStepStore::kPosY); }
+    const std::vector<G4double> &GetPosZ() const { return StepColumn(GasChamberStepStore::kPosZ); }
+    const std::vector<G4double> &GetMomX() const { return StepColumn(GasChamberStepStore::kMomX); }
+    const std::vector<G4double> &GetMomY() const { return StepColumn(GasChamberStepStore::kMomY); }
+    const std::vector<G4double> &GetMomZ() const { return StepColumn(GasChamberStepStore::kMomZ); }
+    const std::vector<G4double> &GetCharge() const {return StepColumn(GasChamberStepStore::kCharge);}
+    const std::vector<G4double> &GetStepLen() const {return StepColumn(GasChamberStepStore::kStepLen);}
     G4double GetEdepSum() const { return fEdepSum; }
     G4double GetTrackLength() const {return fTrackLen;}
     G4int GetTrackId() const {return fTrackId;}
@@ -48,14 +56,16 @@ class GasChamberHit : public G4VHit
     G4double GetMass() const {return fMass;}
     G4String GetPartName() const {return fPartName;}
     G4int GetNbOfStepPoints() const {return fNbOfStepPoints;}
+    // value of a step in Geant4 units, whatever the storage of the column is.
+    G4double GetStepValue(GasChamberStepStore::Column col, G4int i) const;
+    // number of values in a column, zero if the column is not recorded.
+    G4int GetNbOfStepValues(GasChamberStepStore::Column col) const;
 
     // to save information
-    void AppendEdep(G4double de);
-    void AppendTime(G4double t);
-    void AppendCharge(G4double q);
-    void AppendPosition(const G4ThreeVector &pos);
-    void AppendMomentum(const G4ThreeVector &mom);
-    void AppendStepLen(G4double stepLen);
+    // append values of a step indexed by GasChamberStepStore::Column to the given columns only.
+    void AppendStep(const G4double *values, const std::vector<GasChamberStepStore::Column> &columns);
+    // merge values of a step into the last step point, summing edep and step length.
+    void MergeStep(const G4double *values, const std::vector<GasChamberStepStore::Column> &columns);
     void AddEdepSum(G4double de);
     void AddTrackLength(G4double leng);
     void SetTrackId(G4double trkId);
@@ -64,15 +74,51 @@ class GasChamberHit : public G4VHit
     void SetMass(G4double mass);
     void SetPartName(const G4String &name);
     void SetNbOfStepPoints(G4int nSteps);
+    void AddNbOfStepPoints(G4int nSteps);
+
+    // state of step merging, referring to the first step merged into the last step point.
+    void OpenMergePoint(const G4ThreeVector &dir, G4double dedx);
+    void CloseMergePoint() { fMergeOpen = false; }
+    G4bool IsMergePointOpen() const { return fMergeOpen; }
+    const G4ThreeVector &GetMergeDirection() const { return fMergeDir; }
+    G4double GetMergeDedx() const { return fMergeDedx; }
+
+    // Exchange the buffer of a step column with a given vector without copying.
+    // Used to hand step data to ntuple columns, and must be swapped back before the end of event.
+    void SwapStepColumn(GasChamberStepStore::Column col, std::vector<G4double> &other);
+    void SwapStepColumn(GasChamberStepStore::Column col, std::vector<G4float> &other);
+    void SwapStepColumn(GasChamberStepStore::Column col, std::vector<G4int> &other);
+    // Copy a step column into a given vector, reusing its capacity.
+    // Used to hand step data to the asynchronous writer, which keeps them beyond the event.
+    void CopyStepColumn(GasChamberStepStore::Column col, std::vector<G4double> &other) const;
+    void CopyStepColumn(GasChamberStepStore::Column col, std::vector<G4float> &other) const;
+    void CopyStepColumn(GasChamberStepStore::Column col, std::vector<G4int> &other) const;
+    // Append a step column to a given vector, for the flat step arrays of the event layout of tree_gc2.
+    void AppendStepColumn(GasChamberStepStore::Column col, std::vector<G4double> &other) const;
+    void AppendStepColumn(GasChamberStepStore::Column col, std::vector<G4float> &other) const;
+    void AppendStepColumn(GasChamberStepStore::Column col, std::vector<G4int> &other) const;
 
     private:
-    // by steps
-    std::vector<G4double> fPosX, fPosY, fPosZ, fMomX, fMomY, fMomZ, fEdep, fTime, fCharge, fStepLen;
+    const std::vector<G4double> &StepColumn(GasChamberStepStore::Column col) const { return fSteps->columns[col]; }
+    std::vector<G4double> &StepColumn(GasChamberStepStore::Column col) { return fSteps->columns[col]; }
+    // value in units of scale, clamped to the range of G4int.
+    static G4int ToFixedPoint(G4double value, G4double scale);
+
+    private:
+    // by steps, in a slot of the step store
+    GasChamberStepStore::Slot *fSteps;
     
     // by tracks
     G4int fEventId, fTrackId, fZ, fNbOfStepPoints;
     G4double fEdepSum, fTrackLen, fMass;
     G4String fPartName;
+
+    // for step merging
+    G4bool fMergeOpen;
+    G4ThreeVector fMergeDir;
+    G4double fMergeDedx;
+    // unrounded values of the last step point, so that fixed point columns are rounded once after merging.
+    std::array<G4double, GasChamberStepStore::kNbOfColumns> fMergeValues;
 };
 
 using GasChamberHitsCollection = G4THitsCollection<GasChamberHit>;
@@ -7,8 +7,14 @@
 #include "G4VSensitiveDetector.hh"
 
 #include "gas_chamber/GasChamberHit.hh"
+#include "gas_chamber/GasChamberStepStore.hh"
 #include "G4GenericMessenger.hh"
+#include "G4EmCalculator.hh"
+
+#include <vector>
+
 class G4Step;
+class G4Track;
 class G4HCofThisEvent;
 class G4TouchableHistory;
 
@@ -23,15 +29,82 @@ class GasChamberSD : public G4VSensitiveDetector
     virtual void Initialize(G4HCofThisEvent *HCE);
     virtual void EndOfEvent(G4HCofThisEvent *HCE);
     virtual G4bool ProcessHits(G4Step *aStep, G4TouchableHistory *ROhist);
+
+    // Select step columns to be recorded by a list of column names.
+    void SetColumns(const G4String &columnList);
+    void SetMergeSteps(G4bool merge);
+    void SetMergeMaxAngle(G4double angle);
+    // "off", "length" or "dedx"
+    void SetSubStepMode(const G4String &mode);
+    // Select particles to be recorded by a list of particle names, "all" for no selection.
+    void SetFilterParticles(const G4String &particleList);
+    // Remove all track filters.
+    void ResetFilters();
     private:
     GasChamberHitsCollection *fHitsCollection;
+    // arena of step data of this thread, recycled by every event.
+    GasChamberStepStore *fStepStore;
     G4GenericMessenger *fMessenger;
+    G4GenericMessenger *fFilterMessenger;
     G4int fHCID;
     G4int fEventId;
+    // the last track processed and its hit
     G4int fTrackId;
-    G4int fNbOfStepPoints;
+    GasChamberHit *fCurrentHit;
+    // index of the hit of each track in the hits collection, -1 if none yet
+    // and kRejectedTrack if the track is rejected by the filters.
+    // Track IDs are small positive integers within an event, so they index the vector directly.
+    std::vector<G4int> fHitIndexOfTrack;
+    G4int fMaxTrackId;
+
+    // step columns recorded, and whether the momentum is needed by any of them.
+    std::vector<GasChamberStepStore::Column> fRecordedColumns;
+    G4bool fRecordMomentum;
+
+    // Step merging mode.
+    // Consecutive steps are merged into one step point while the direction and dE/dx
+    // stay within tolerances, except for the last part of the range of a track.
+    G4bool fMergeSteps;
+    // cosine of the maximum angle between the directions of the first and the current step
+    G4double fMergeCosMaxAngle;
+    G4double fMergeMaxDedxChange;
+    G4double fMergeFullResolutionRange;
+    G4EmCalculator fEmCalculator;
+
+    // Track filters, evaluated once at the first step of a track in the chamber.
+    // Steps of rejected tracks are not recorded at all.
+    std::vector<G4String> fFilterParticles;
+    G4bool fFilterChargedOnly;
+    G4double fFilterMinKineticEnergy;
+    G4int fFilterMaxParentId;
+    G4bool fFilterPrimaryOnly;
+
+    // Sub-step mode.
+    // The deposit of a step is distributed uniformly to N points along the step,
+    // at the midpoints of N equal segments, so that the charge is not shifted along the step. N is given by the step length over fSubStepLength ("length"),
+    // or by the energy deposit over fSubStepEnergy, i.e. proportional to dE/dx ("dedx").
+    // Exclusive with step merging.
+    enum SubStepMode
+    {
+        kSubStepOff, kSubStepLength, kSubStepDedx
+    };
+    SubStepMode fSubStepMode;
+    G4double fSubStepLength;
+    G4double fSubStepEnergy;
+    G4int fMaxNbOfSubSteps;
+
+    static constexpr G4int kInitialNbOfTrackIds = 64;
+    static constexpr G4int kRejectedTrack = -2;
 
     private:
+    // nullptr if the track is rejected by the filters.
+    GasChamberHit *FindOrCreateHit(const G4Step *step);
+    G4bool AcceptTrack(const G4Step *step) const;
+    G4int GetNbOfSubSteps(const G4Step *step) const;
+    // append N points along the step, interpolating the values of the pre and post step points.
+    void AppendSubSteps(const G4Step *step, GasChamberHit *hit, G4double *values, G4int nbOfSubSteps);
+    G4bool IsMergeable(const G4Step *step, const GasChamberHit *hit,
+        const G4ThreeVector &dir, G4double dedx);
     void DefineCommands();
 };
 
@@ -0,0 +1,89 @@
+/// \file GasChamberStepStore.hh
+/// \brief Definition of the GasChamberStepStore class
+
+#ifndef GasChamberStepStore_h
+#define GasChamberStepStore_h 1
+
+#include "globals.hh"
+
+#include <array>
+#include <bitset>
+#include <deque>
+#include <vector>
+
+/// Event arena holding the step columns of the gas chamber hits.
+///
+/// Each hit of an event takes one slot of the arena, and every column of a slot
+/// is a contiguous buffer. Slots are recycled by Reset() at the beginning of the next event
+/// with their capacity kept, so no heap allocation happens once the arena has warmed up.
+/// One arena is owned by each (thread local) GasChamberSD.
+class GasChamberStepStore
+{
+    public:
+    enum Column
+    {
+        kPosX, kPosY, kPosZ, kMomX, kMomY, kMomZ, kEdep, kTime, kCharge, kStepLen,
+        kNbOfColumns
+    };
+
+    // storage type of a column in hits and in the ntuple
+    enum Storage
+    {
+        kDouble, kFloat, kFixedPoint
+    };
+
+    // A fixed point column stores values rounded to integer multiples of scale (in Geant4 units).
+    struct ColumnStorage
+    {
+        Storage type;
+        G4double scale;
+    };
+
+    // Only the buffer of the storage type of a column is used.
+    struct Slot
+    {
+        std::array<std::vector<G4double>, kNbOfColumns> columns;
+        std::array<std::vector<G4float>, kNbOfColumns> columnsF;
+        std::array<std::vector<G4int>, kNbOfColumns> columnsI;
+    };
+
+    // set of columns to be recorded or written
+    using ColumnMask = std::bitset<kNbOfColumns>;
+
+    public:
+    GasChamberStepStore();
+    virtual ~GasChamberStepStore();
+
+    // Get an empty slot for a new hit. The returned pointer is valid until Reset().
+    Slot *AcquireSlot();
+    // Release all slots of the previous event, keeping their buffers.
+    void Reset();
+
+    G4int GetNbOfSlotsInUse() const { return fNbOfSlotsInUse; }
+    G4int GetNbOfSlots() const { return fSlots.size(); }
+
+    // column names, also used as the names of the ntuple columns.
+    static const G4String &GetColumnName(Column col);
+    // Parse a list of column names separated by spaces or commas.
+    // "all" and "none" select all and no columns, and unknown names are ignored with a warning.
+    static ColumnMask ParseColumns(const G4String &columnList);
+    static std::vector<Column> ToColumnList(const ColumnMask &mask);
+    // whether values of a column are summed when steps are merged (edep and step length),
+    // instead of taking the value of the last step.
+    static G4bool IsAdditive(Column col) { return col == kEdep || col == kStepLen; }
+
+    // Storage of a column, given by "storage" in parameters/gas_chamber.txt and common to all threads.
+    static const ColumnStorage &GetColumnStorage(Column col);
+    // Parse a list of storage specifications "column:type[:scale]" separated by spaces or commas,
+    // where type is double, float or int. The column "all" applies to all columns.
+    static std::array<ColumnStorage, kNbOfColumns> ParseStorage(const G4String &storageList);
+
+    private:
+    // deque keeps the address of slots when growing.
+    std::deque<Slot> fSlots;
+    G4int fNbOfSlotsInUse;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,39 @@
+/// \file GasChamberTrackSummary.hh
+/// \brief Definition of the GasChamberTrackSummary struct
+
+#ifndef GasChamberTrackSummary_h
+#define GasChamberTrackSummary_h 1
+
+#include "gas_chamber/GasChamberHit.hh"
+#include "globals.hh"
+
+#include <array>
+
+/// Summary quantities of a track in the gas chamber, computed in one pass over the step points of its hit,
+/// for analyses which do not need the step columns.
+///
+/// - range : distance between the first and the last step points
+/// - braggPos, braggDedx : path length from the start of the track to the step point of the highest dE/dx,
+///   and that dE/dx, as the curve of rmacros/DrawBraggsCurve.cc
+/// - dirX, dirY, dirZ : unit vector from the first to the last step point
+/// Positions x, y, z and eDep must be recorded. Step lengths are taken from stepLen if recorded,
+/// and from the distance between step points otherwise, in which case the first step point has no dE/dx.
+/// Values are zero if they cannot be computed.
+struct GasChamberTrackSummary
+{
+    enum Value
+    {
+        kRange, kBraggPos, kBraggDedx, kDirX, kDirY, kDirZ,
+        kNbOfValues
+    };
+
+    std::array<G4double, kNbOfValues> values{};
+
+    void Compute(const GasChamberHit &hit);
+    // name of the column of a value in tree_gc2
+    static const char *GetColumnName(Value value);
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,66 @@
+/// \file GasChamberVoxelHit.hh
+/// \brief Definition of the GasChamberVoxelHit class
+
+#ifndef GasChamberVoxelHit_h
+#define GasChamberVoxelHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+
+#include "gas_chamber/GasChamberVoxelMap.hh"
+
+/// Gas chamber voxel hit class
+///
+/// One hit per event, referring to the voxel map of the GasChamberVoxelSD,
+/// which is valid until the SD is initialized for the next event.
+
+class GasChamberVoxelHit : public G4VHit
+{
+    public:
+    GasChamberVoxelHit();
+    GasChamberVoxelHit(G4int evtId, const GasChamberVoxelMap *voxelMap);
+    GasChamberVoxelHit(const GasChamberVoxelHit &right);
+    virtual ~GasChamberVoxelHit();
+
+    const GasChamberVoxelHit &operator=(const GasChamberVoxelHit &right);
+    G4bool operator==(const GasChamberVoxelHit &right) const;
+
+    inline void *operator new(size_t);
+    inline void operator delete(void *aHit);
+
+    virtual void Print();
+
+    G4int GetEventId() const { return fEventId; }
+    const GasChamberVoxelMap *GetVoxelMap() const { return fVoxelMap; }
+    // energy deposit outside of the voxel grid
+    G4double GetEdepOutside() const { return fEdepOutside; }
+    void AddEdepOutside(G4double de) { fEdepOutside += de; }
+
+    private:
+    G4int fEventId;
+    const GasChamberVoxelMap *fVoxelMap;
+    G4double fEdepOutside;
+};
+
+using GasChamberVoxelHitsCollection = G4THitsCollection<GasChamberVoxelHit>;
+
+extern G4ThreadLocal G4Allocator<GasChamberVoxelHit> *GasChamberVoxelHitAllocator;
+
+inline void *GasChamberVoxelHit::operator new(size_t)
+{
+    if(!GasChamberVoxelHitAllocator)
+    {
+        GasChamberVoxelHitAllocator = new G4Allocator<GasChamberVoxelHit>;
+    }
+    return (void *)GasChamberVoxelHitAllocator->MallocSingle();
+}
+
+inline void GasChamberVoxelHit::operator delete(void *aHit)
+{
+    GasChamberVoxelHitAllocator->FreeSingle((GasChamberVoxelHit *)aHit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
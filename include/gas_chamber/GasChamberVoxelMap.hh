@@ -0,0 +1,45 @@
+/// \file GasChamberVoxelMap.hh
+/// \brief Definition of the GasChamberVoxelMap class
+
+#ifndef GasChamberVoxelMap_h
+#define GasChamberVoxelMap_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Sparse map of energy deposits of an event keyed by voxel index.
+///
+/// Voxel indices are looked up in an open addressing hash table with linear probing,
+/// and the occupied voxels are kept in insertion order in two dense arrays,
+/// so memory is bounded by the number of occupied voxels, not by the number of steps.
+/// Clear() only resets the occupied buckets and keeps the capacity.
+class GasChamberVoxelMap
+{
+    public:
+    GasChamberVoxelMap(G4int initialCapacity = 1024);
+    virtual ~GasChamberVoxelMap();
+
+    void Add(G4int voxelId, G4double edep);
+    void Clear();
+
+    G4int GetNbOfVoxels() const { return fVoxelIds.size(); }
+    const std::vector<G4int> &GetVoxelIds() const { return fVoxelIds; }
+    const std::vector<G4double> &GetEdeps() const { return fEdeps; }
+
+    private:
+    size_t Hash(G4int voxelId) const;
+    void Rehash(size_t capacity);
+
+    private:
+    // index in the dense arrays, or -1 if the bucket is empty. The capacity is a power of two.
+    std::vector<G4int> fBuckets;
+    size_t fMask;
+    // occupied voxels
+    std::vector<G4int> fVoxelIds;
+    std::vector<G4double> fEdeps;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
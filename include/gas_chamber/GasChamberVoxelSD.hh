@@ -0,0 +1,56 @@
+/// \file GasChamberVoxelSD.hh
+/// \brief Definition of the GasChamberVoxelSD class
+
+#ifndef GasChamberVoxelSD_h
+#define GasChamberVoxelSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+#include "gas_chamber/GasChamberVoxelHit.hh"
+#include "gas_chamber/GasChamberVoxelMap.hh"
+#include "G4ThreeVector.hh"
+
+class G4Step;
+class G4HCofThisEvent;
+class G4TouchableHistory;
+class G4VTouchable;
+
+/// Gas chamber sensitive detector accumulating energy deposits on a voxel grid
+///
+/// The grid covers the bounding box of the chamber solid in the local frame of the chamber
+/// with voxels of "voxelSize", so that it follows the placement of the chamber whatever it is.
+/// It is made at the first step in the chamber from the solid and the transform of its touchable.
+/// The voxel index is (iz*ny + iy)*nx + ix with ix, iy and iz along the local x, y and z axes.
+/// The deposit of a step is given to the voxel of the middle of the step.
+
+class GasChamberVoxelSD : public G4VSensitiveDetector
+{
+    public:
+    GasChamberVoxelSD(G4String name, G4int verbose = 0);
+    virtual ~GasChamberVoxelSD();
+
+    virtual void Initialize(G4HCofThisEvent *HCE);
+    virtual G4bool ProcessHits(G4Step *aStep, G4TouchableHistory *ROhist);
+
+    // voxel index of a position in the local frame of the chamber, -1 if outside the grid
+    G4int GetVoxelId(const G4ThreeVector &localPos) const;
+
+    private:
+    void BuildGrid(const G4VTouchable *touchable);
+
+    private:
+    GasChamberVoxelHitsCollection *fHitsCollection;
+    GasChamberVoxelHit *fHit;
+    GasChamberVoxelMap *fVoxelMap;
+    G4int fHCID;
+
+    // voxel grid
+    G4bool fGridBuilt;
+    G4ThreeVector fGridOrigin;
+    G4double fVoxelSize[3];
+    G4int fNbOfVoxels[3];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,48 @@
+/// \file AncillaryRecorders.hh
+/// \brief Definition of the recorder traits of ancillary detectors
+
+#ifndef AncillaryRecorders_h
+#define AncillaryRecorders_h 1
+
+#include "recorder/RecorderFields.hh"
+
+/// Traits of the ancillary detectors recorded by RecorderSD and RecorderNtuple.
+///
+/// A new detector is added by declaring its traits here, adding them to ForEachAncillaryRecorder(),
+/// and enabling it in parameters/ancillary.txt
+/// by "<kName>" and the name of its logical volume "<kName>Volume".
+/// The SD is constructed in DetectorConstruction::ConstructSDandField() and
+/// the ntuple "tree_<kName>" is booked by RunAction and filled by EventAction.
+
+// silicon detector, with the position of every step
+struct SiliconRecorderTraits
+{
+    static constexpr const char *kName = "silicon";
+    using StepFields = RecorderFieldList<RecorderFields::PosX, RecorderFields::PosY, RecorderFields::PosZ,
+        RecorderFields::Edep, RecorderFields::Time>;
+    using TrackFields = RecorderFieldList<RecorderFields::TrackId, RecorderFields::ParentId, RecorderFields::PdgCode,
+        RecorderFields::EntryKineticEnergy, RecorderFields::EdepSum>;
+};
+
+// scintillator, with the time structure of the deposit
+struct ScintillatorRecorderTraits
+{
+    static constexpr const char *kName = "scintillator";
+    using StepFields = RecorderFieldList<RecorderFields::Edep, RecorderFields::Time>;
+    using TrackFields = RecorderFieldList<RecorderFields::TrackId, RecorderFields::PdgCode,
+        RecorderFields::EntryTime, RecorderFields::EdepSum>;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Call a generic function with the traits of every ancillary detector, e.g. [](auto traits) {...}.
+template<typename Function>
+void ForEachAncillaryRecorder(Function &&function)
+{
+    function(SiliconRecorderTraits());
+    function(ScintillatorRecorderTraits());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
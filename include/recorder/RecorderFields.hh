@@ -0,0 +1,220 @@
+/// \file RecorderFields.hh
+/// \brief Definition of the RecorderFieldList class template and common recorder fields
+
+#ifndef RecorderFields_h
+#define RecorderFields_h 1
+
+#include "AnalysisManager.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "globals.hh"
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// Ntuple column operations by value type, resolved at compile time.
+template<typename T>
+struct RecorderColumn;
+
+template<>
+struct RecorderColumn<G4double>
+{
+    static G4int Create(G4int ntupleId, const G4String &name)
+    { return G4AnalysisManager::Instance()->CreateNtupleDColumn(ntupleId, name); }
+    static G4int Create(G4int ntupleId, const G4String &name, std::vector<G4double> &vec)
+    { return G4AnalysisManager::Instance()->CreateNtupleDColumn(ntupleId, name, vec); }
+    static void Fill(G4int ntupleId, G4int columnId, G4double value)
+    { G4AnalysisManager::Instance()->FillNtupleDColumn(ntupleId, columnId, value); }
+};
+
+template<>
+struct RecorderColumn<G4float>
+{
+    static G4int Create(G4int ntupleId, const G4String &name)
+    { return G4AnalysisManager::Instance()->CreateNtupleFColumn(ntupleId, name); }
+    static G4int Create(G4int ntupleId, const G4String &name, std::vector<G4float> &vec)
+    { return G4AnalysisManager::Instance()->CreateNtupleFColumn(ntupleId, name, vec); }
+    static void Fill(G4int ntupleId, G4int columnId, G4float value)
+    { G4AnalysisManager::Instance()->FillNtupleFColumn(ntupleId, columnId, value); }
+};
+
+template<>
+struct RecorderColumn<G4int>
+{
+    static G4int Create(G4int ntupleId, const G4String &name)
+    { return G4AnalysisManager::Instance()->CreateNtupleIColumn(ntupleId, name); }
+    static G4int Create(G4int ntupleId, const G4String &name, std::vector<G4int> &vec)
+    { return G4AnalysisManager::Instance()->CreateNtupleIColumn(ntupleId, name, vec); }
+    static void Fill(G4int ntupleId, G4int columnId, G4int value)
+    { G4AnalysisManager::Instance()->FillNtupleIColumn(ntupleId, columnId, value); }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// List of fields recorded by a detector.
+///
+/// A field is a struct with a value type "Type" and a column name "kName".
+/// - A step field gives its value of a step by "static Type Get(const G4Step *)",
+///   and is recorded in a vector column with one entry per step.
+/// - A track field gives its value at the first step of a track by "static Type Init(const G4Step *)"
+///   and updates it at every step by "static void Update(Type &, const G4Step *)".
+///
+/// All the loops over fields are unrolled at compile time, so that recording
+/// costs as much as hand-written code, without any name lookup or virtual call.
+template<typename... Fields>
+struct RecorderFieldList
+{
+    using Values = std::tuple<typename Fields::Type...>;
+    using Columns = std::tuple<std::vector<typename Fields::Type>...>;
+    static constexpr std::size_t kNbOfFields = sizeof...(Fields);
+
+    // for step fields
+    static void Append(Columns &columns, const G4Step *step)
+    { Append(columns, step, std::index_sequence_for<Fields...>()); }
+    static void Clear(Columns &columns)
+    { std::apply([](auto &... column) { (column.clear(), ...); }, columns); }
+    static void Swap(Columns &columns, Columns &other)
+    { Swap(columns, other, std::index_sequence_for<Fields...>()); }
+    static void CreateVectorColumns(G4int ntupleId, Columns &bound)
+    { CreateVectorColumns(ntupleId, bound, std::index_sequence_for<Fields...>()); }
+
+    // for track fields
+    static void Init(Values &values, const G4Step *step)
+    { values = Values(Fields::Init(step)...); }
+    static void Update(Values &values, const G4Step *step)
+    { Update(values, step, std::index_sequence_for<Fields...>()); }
+    static void CreateColumns(G4int ntupleId)
+    { (RecorderColumn<typename Fields::Type>::Create(ntupleId, Fields::kName), ...); }
+    // fill columns from firstColumnId in the order of the fields.
+    static void FillColumns(G4int ntupleId, G4int firstColumnId, const Values &values)
+    { FillColumns(ntupleId, firstColumnId, values, std::index_sequence_for<Fields...>()); }
+
+    private:
+    template<std::size_t... I>
+    static void Append(Columns &columns, const G4Step *step, std::index_sequence<I...>)
+    { (std::get<I>(columns).push_back(Fields::Get(step)), ...); }
+    template<std::size_t... I>
+    static void Swap(Columns &columns, Columns &other, std::index_sequence<I...>)
+    { (std::get<I>(columns).swap(std::get<I>(other)), ...); }
+    template<std::size_t... I>
+    static void CreateVectorColumns(G4int ntupleId, Columns &bound, std::index_sequence<I...>)
+    { (RecorderColumn<typename Fields::Type>::Create(ntupleId, Fields::kName, std::get<I>(bound)), ...); }
+    template<std::size_t... I>
+    static void Update(Values &values, const G4Step *step, std::index_sequence<I...>)
+    { (Fields::Update(std::get<I>(values), step), ...); }
+    template<std::size_t... I>
+    static void FillColumns(G4int ntupleId, G4int firstColumnId, const Values &values, std::index_sequence<I...>)
+    { (RecorderColumn<typename Fields::Type>::Fill(ntupleId, firstColumnId + I, std::get<I>(values)), ...); }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Fields common to detectors. Positions and times are taken at the post step point.
+namespace RecorderFields
+{
+    // step fields
+    struct PosX
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "x";
+        static Type Get(const G4Step *step) { return step->GetPostStepPoint()->GetPosition().x(); }
+    };
+
+    struct PosY
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "y";
+        static Type Get(const G4Step *step) { return step->GetPostStepPoint()->GetPosition().y(); }
+    };
+
+    struct PosZ
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "z";
+        static Type Get(const G4Step *step) { return step->GetPostStepPoint()->GetPosition().z(); }
+    };
+
+    struct Time
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "t";
+        static Type Get(const G4Step *step) { return step->GetPostStepPoint()->GetGlobalTime(); }
+    };
+
+    struct Edep
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "eDep";
+        static Type Get(const G4Step *step) { return step->GetTotalEnergyDeposit(); }
+    };
+
+    struct StepLength
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "stepLen";
+        static Type Get(const G4Step *step) { return step->GetStepLength(); }
+    };
+
+    // track fields
+    struct TrackId
+    {
+        using Type = G4int;
+        static constexpr const char *kName = "trkId";
+        static Type Init(const G4Step *step) { return step->GetTrack()->GetTrackID(); }
+        static void Update(Type &, const G4Step *) {}
+    };
+
+    struct ParentId
+    {
+        using Type = G4int;
+        static constexpr const char *kName = "parentId";
+        static Type Init(const G4Step *step) { return step->GetTrack()->GetParentID(); }
+        static void Update(Type &, const G4Step *) {}
+    };
+
+    struct PdgCode
+    {
+        using Type = G4int;
+        static constexpr const char *kName = "pdg";
+        static Type Init(const G4Step *step) { return step->GetTrack()->GetParticleDefinition()->GetPDGEncoding(); }
+        static void Update(Type &, const G4Step *) {}
+    };
+
+    // kinetic energy when entering or created in the detector
+    struct EntryKineticEnergy
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "kinE";
+        static Type Init(const G4Step *step) { return step->GetPreStepPoint()->GetKineticEnergy(); }
+        static void Update(Type &, const G4Step *) {}
+    };
+
+    struct EntryTime
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "t0";
+        static Type Init(const G4Step *step) { return step->GetPreStepPoint()->GetGlobalTime(); }
+        static void Update(Type &, const G4Step *) {}
+    };
+
+    struct EdepSum
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "eDepSum";
+        static Type Init(const G4Step *) { return 0.; }
+        static void Update(Type &sum, const G4Step *step) { sum += step->GetTotalEnergyDeposit(); }
+    };
+
+    struct TrackLength
+    {
+        using Type = G4double;
+        static constexpr const char *kName = "trkLen";
+        static Type Init(const G4Step *) { return 0.; }
+        static void Update(Type &sum, const G4Step *step) { sum += step->GetStepLength(); }
+    };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
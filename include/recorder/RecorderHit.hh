@@ -0,0 +1,86 @@
+/// \file RecorderHit.hh
+/// \brief Definition of the RecorderHit class template
+
+#ifndef RecorderHit_h
+#define RecorderHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "G4Step.hh"
+
+#include "recorder/RecorderFields.hh"
+
+/// Hit of a track in a detector recorded by RecorderSD.
+///
+/// Traits of a detector give the fields recorded:
+/// - Traits::StepFields : RecorderFieldList of step fields, recorded in vectors by step
+/// - Traits::TrackFields : RecorderFieldList of track fields
+///
+/// Step columns are not owned by the hit, but kept in a slot of the RecorderSD,
+/// which is valid until the SD is initialized for the next event.
+template<typename Traits>
+class RecorderHit : public G4VHit
+{
+    public:
+    using StepFields = typename Traits::StepFields;
+    using TrackFields = typename Traits::TrackFields;
+    using StepColumns = typename StepFields::Columns;
+    using TrackValues = typename TrackFields::Values;
+
+    public:
+    // the hit is created at the first step of a track in the detector, which is then processed as the others.
+    RecorderHit(const G4Step *step, StepColumns *stepColumns)
+        : G4VHit(), fStepColumns(stepColumns), fTrackValues(), fNbOfSteps(0)
+    { TrackFields::Init(fTrackValues, step); }
+    virtual ~RecorderHit() {}
+
+    inline void *operator new(size_t);
+    inline void operator delete(void *aHit);
+
+    // update the track fields, at every step of the track.
+    void UpdateTrack(const G4Step *step) { TrackFields::Update(fTrackValues, step); }
+    // append a step to the step columns.
+    void AppendStep(const G4Step *step)
+    {
+        StepFields::Append(*fStepColumns, step);
+        ++fNbOfSteps;
+    }
+
+    G4int GetNbOfSteps() const { return fNbOfSteps; }
+    const StepColumns &GetStepColumns() const { return *fStepColumns; }
+    const TrackValues &GetTrackValues() const { return fTrackValues; }
+    // Exchange the step buffers with given vectors without copying, e.g. with ntuple columns.
+    void SwapStepColumns(StepColumns &other) { StepFields::Swap(*fStepColumns, other); }
+
+    private:
+    // in a slot of the SD
+    StepColumns *fStepColumns;
+    TrackValues fTrackValues;
+    G4int fNbOfSteps;
+
+    static G4ThreadLocal G4Allocator<RecorderHit> *fAllocator;
+};
+
+template<typename Traits>
+G4ThreadLocal G4Allocator<RecorderHit<Traits> > *RecorderHit<Traits>::fAllocator = nullptr;
+
+template<typename Traits>
+inline void *RecorderHit<Traits>::operator new(size_t)
+{
+    if(!fAllocator)
+    {
+        fAllocator = new G4Allocator<RecorderHit>;
+    }
+    return (void *)fAllocator->MallocSingle();
+}
+
+template<typename Traits>
+inline void RecorderHit<Traits>::operator delete(void *aHit)
+{
+    fAllocator->FreeSingle((RecorderHit *)aHit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
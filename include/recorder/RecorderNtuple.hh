@@ -0,0 +1,93 @@
+/// \file RecorderNtuple.hh
+/// \brief Definition of the RecorderNtuple class template
+
+#ifndef RecorderNtuple_h
+#define RecorderNtuple_h 1
+
+#include "AnalysisManager.hh"
+#include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SDManager.hh"
+
+#include "recorder/RecorderSD.hh"
+
+/// Interface of recorder ntuples, booked by RunAction and filled by EventAction.
+class RecorderNtupleBase
+{
+    public:
+    virtual ~RecorderNtupleBase() {}
+    virtual void Book() = 0;
+    virtual void Fill(const G4Event *event) = 0;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Ntuple "tree_<kName>" of the hits of a RecorderSD, one row per track.
+///
+/// Columns are evtId, Nstep, the track fields and the step fields as vectors.
+/// Tracks without energy deposit in the detector have no row.
+/// The step vectors of a hit are swapped with the bound columns for its row, so they are not copied.
+template<typename Traits>
+class RecorderNtuple : public RecorderNtupleBase
+{
+    public:
+    using Hit = RecorderHit<Traits>;
+    using HitsCollection = G4THitsCollection<Hit>;
+
+    public:
+    RecorderNtuple() : fNtupleId(-1), fHCID(-1), fHCIDResolved(false), fBoundColumns() {}
+    virtual ~RecorderNtuple() {}
+
+    virtual void Book()
+    {
+        auto analysisManager = G4AnalysisManager::Instance();
+        fNtupleId = analysisManager->CreateNtuple(G4String("tree_") + Traits::kName,
+            G4String(Traits::kName) + " hit data saved by trk");
+        analysisManager->CreateNtupleIColumn(fNtupleId, "evtId");
+        analysisManager->CreateNtupleIColumn(fNtupleId, "Nstep");
+        Traits::TrackFields::CreateColumns(fNtupleId);
+        Traits::StepFields::CreateVectorColumns(fNtupleId, fBoundColumns);
+        analysisManager->FinishNtuple(fNtupleId);
+    }
+
+    virtual void Fill(const G4Event *event)
+    {
+        // resolved at the first event, after the SDs are constructed. -1 if the SD is not constructed.
+        if(!fHCIDResolved)
+        {
+            fHCIDResolved = true;
+            fHCID = G4SDManager::GetSDMpointer()->GetCollectionID(
+                G4String(Traits::kName) + "/" + Traits::kName + "HColl");
+        }
+        auto hce = event->GetHCofThisEvent();
+        if(fHCID < 0 || !hce)
+            return;
+        auto hitCol = static_cast<HitsCollection *>(hce->GetHC(fHCID));
+        if(!hitCol)
+            return;
+
+        auto analysisManager = G4AnalysisManager::Instance();
+        for(size_t i = 0;i < hitCol->GetSize();++i)
+        {
+            auto hit = (*hitCol)[i];
+            if(hit->GetNbOfSteps() == 0)
+                continue;
+            analysisManager->FillNtupleIColumn(fNtupleId, 0, event->GetEventID());
+            analysisManager->FillNtupleIColumn(fNtupleId, 1, hit->GetNbOfSteps());
+            Traits::TrackFields::FillColumns(fNtupleId, 2, hit->GetTrackValues());
+            hit->SwapStepColumns(fBoundColumns);
+            analysisManager->AddNtupleRow(fNtupleId);
+            hit->SwapStepColumns(fBoundColumns);
+        }
+    }
+
+    private:
+    G4int fNtupleId;
+    G4int fHCID;
+    G4bool fHCIDResolved;
+    typename Traits::StepFields::Columns fBoundColumns;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,116 @@
+/// \file RecorderSD.hh
+/// \brief Definition of the RecorderSD class template
+
+#ifndef RecorderSD_h
+#define RecorderSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SDManager.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+
+#include "recorder/RecorderHit.hh"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+/// Generic sensitive detector recording one RecorderHit per track.
+///
+/// Traits::kName names the SD "/<kName>" and its hits collection "<kName>HColl".
+/// The hit of a track is created at its first step in the detector, and all steps update its track fields,
+/// but steps with no energy deposit are not recorded in the step columns.
+/// Step columns of hits are kept in slots recycled at every event with their capacity,
+/// so no heap allocation happens once the slots have warmed up, as GasChamberStepStore does.
+template<typename Traits>
+class RecorderSD : public G4VSensitiveDetector
+{
+    public:
+    using Hit = RecorderHit<Traits>;
+    using HitsCollection = G4THitsCollection<Hit>;
+
+    public:
+    RecorderSD()
+        : G4VSensitiveDetector(G4String("/") + Traits::kName),
+        fHitsCollection(nullptr), fHCID(-1), fTrackId(-1), fCurrentHit(nullptr),
+        fHitIndexOfTrack(kInitialNbOfTrackIds, -1), fMaxTrackId(0), fStepSlots(), fNbOfStepSlotsInUse(0)
+    { collectionName.insert(G4String(Traits::kName) + "HColl"); }
+    virtual ~RecorderSD() {}
+
+    virtual void Initialize(G4HCofThisEvent *hce)
+    {
+        fHitsCollection = new HitsCollection(SensitiveDetectorName, collectionName[0]);
+        if(fHCID < 0)
+        {
+            fHCID = G4SDManager::GetSDMpointer()->GetCollectionID(fHitsCollection);
+        }
+        hce->AddHitsCollection(fHCID, fHitsCollection);
+
+        fTrackId = -1;
+        fCurrentHit = nullptr;
+        std::fill(fHitIndexOfTrack.begin(), fHitIndexOfTrack.begin() + fMaxTrackId + 1, -1);
+        fMaxTrackId = 0;
+        // clear() keeps the capacity of the buffers.
+        for(G4int i = 0;i < fNbOfStepSlotsInUse;++i)
+            Traits::StepFields::Clear(fStepSlots[i]);
+        fNbOfStepSlotsInUse = 0;
+    }
+
+    virtual G4bool ProcessHits(G4Step *step, G4TouchableHistory *)
+    {
+        // look up the hit only if the track has changed since the last step.
+        const G4int trackId = step->GetTrack()->GetTrackID();
+        if(fTrackId != trackId)
+        {
+            fTrackId = trackId;
+            fCurrentHit = FindOrCreateHit(step);
+        }
+        fCurrentHit->UpdateTrack(step);
+        if(step->GetTotalEnergyDeposit() <= 0.)
+            return false;
+        fCurrentHit->AppendStep(step);
+        return true;
+    }
+
+    private:
+    Hit *FindOrCreateHit(const G4Step *step)
+    {
+        const G4int trackId = step->GetTrack()->GetTrackID();
+        if(trackId >= static_cast<G4int>(fHitIndexOfTrack.size()))
+            fHitIndexOfTrack.resize(2*trackId, -1);
+        fMaxTrackId = std::max(fMaxTrackId, trackId);
+
+        G4int &index = fHitIndexOfTrack[trackId];
+        if(index < 0)
+            index = fHitsCollection->insert(new Hit(step, AcquireStepSlot())) - 1;
+        return (*fHitsCollection)[index];
+    }
+
+    // Get empty step columns for a new hit, valid until the next event.
+    typename Hit::StepColumns *AcquireStepSlot()
+    {
+        if(fNbOfStepSlotsInUse == static_cast<G4int>(fStepSlots.size()))
+            fStepSlots.emplace_back();
+        return &fStepSlots[fNbOfStepSlotsInUse++];
+    }
+
+    private:
+    HitsCollection *fHitsCollection;
+    G4int fHCID;
+    // the last track processed and its hit
+    G4int fTrackId;
+    Hit *fCurrentHit;
+    // index of the hit of each track in the hits collection, -1 if none yet.
+    std::vector<G4int> fHitIndexOfTrack;
+    G4int fMaxTrackId;
+    // step columns of the hits, deque keeps their address when growing.
+    std::deque<typename Hit::StepColumns> fStepSlots;
+    G4int fNbOfStepSlotsInUse;
+
+    static constexpr G4int kInitialNbOfTrackIds = 64;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,46 @@
+/// \file RedigitizeOutput.hh
+/// \brief Definition of the RedigitizeOutput class
+
+#ifndef RedigitizeOutput_h
+#define RedigitizeOutput_h 1
+
+#include "digitizer/DigitizerColumns.hh"
+#include "digitizer/DigitizerEvent.hh"
+#include "config/ParamContainer.hh"
+#include "analysis/OutputSettings.hh"
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include <mutex>
+#include <vector>
+
+/// Output file of the re-digitization, with the trees of DigitizerColumns as DigitizerNtuple,
+/// so that both outputs are analyzed alike.
+/// Every tree has in addition fileId, the index of the input file of the event, as files of different runs share evtId.
+/// Events are filled by the worker threads under a mutex, in the order they are finished.
+/// Compression and basket settings are those of compression, basketSize and autoFlush in parameters/redigitize.txt.
+class RedigitizeOutput
+{
+    public:
+    RedigitizeOutput(const G4String &fileName, const ParamContainer *params, const OutputSettings &settings);
+    virtual ~RedigitizeOutput();
+
+    void Fill(const DigitizerEvent &event, G4int fileId);
+    // Write the trees, close the file and print the compression of the trees.
+    void Close();
+
+    private:
+    std::mutex fMutex;
+    TFile *fFile;
+    DigitizerColumns fColumns;
+    // trees of fColumns, with fileId in addition
+    std::vector<TTree *> fTrees;
+    // time spent in filling and writing the trees, which includes the compression
+    G4double fWriteTime;
+    Int_t fFileId;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,75 @@
+/// \file StepTreeReader.hh
+/// \brief Definition of the StepTreeReader class
+
+#ifndef StepTreeReader_h
+#define StepTreeReader_h 1
+
+#include "digitizer/DigitizerEvent.hh"
+#include "gas_chamber/GasChamberStepStore.hh"
+
+#include "TChain.h"
+#include "TTreeReader.h"
+#include "TTreeReaderArray.h"
+
+#include <memory>
+#include <vector>
+
+/// Reader of the energy deposits of events from tree_gc2 of the simulation output, for re-digitization.
+///
+/// tree_gc2 has one entry per track, so the entries of every event are indexed once by BuildIndex()
+/// from evtId. In the event layout, an event has one entry whose step columns hold the steps of all tracks.
+/// Events are identified by their file in the chain and evtId, as files of different runs share event ids.
+/// Step columns x, y, z, eDep and t are read with the type of their branches,
+/// vector<double>, vector<float> or vector<int>, and int columns are scaled back by the scales of
+/// storage, given as in parameters/gas_chamber.txt. Steps have t = 0 if t was not stored.
+/// The input may be a list of files, wildcards or shard manifests (*.txt), read as one chain.
+/// Each thread reads the input through its own reader.
+class StepTreeReader
+{
+    public:
+    // entries of tree_gc2 of an event, in the file fileId of the chain
+    struct EventEntries
+    {
+        G4int fileId;
+        G4int eventId;
+        std::vector<Long64_t> entries;
+    };
+
+    public:
+    StepTreeReader(const G4String &fileNames, const G4String &storage);
+    virtual ~StepTreeReader();
+
+    // entries of all events of the input, in the order of files and event ids
+    static std::vector<EventEntries> BuildIndex(const G4String &fileNames);
+    // Append the steps of all tracks of an event to steps.
+    void ReadEvent(const EventEntries &event, DigitizerSteps &steps);
+
+    private:
+    // step column read through the reader of the type of its branch
+    struct StepColumn
+    {
+        GasChamberStepStore::Storage type = GasChamberStepStore::kDouble;
+        G4double scale = 1.;
+        std::unique_ptr<TTreeReaderArray<Double_t>> valuesD;
+        std::unique_ptr<TTreeReaderArray<Float_t>> valuesF;
+        std::unique_ptr<TTreeReaderArray<Int_t>> valuesI;
+
+        G4bool IsValid() const { return valuesD || valuesF || valuesI; }
+        std::size_t GetSize() const;
+        G4double Get(std::size_t i);
+    };
+
+    static void AddFiles(TChain &chain, const G4String &fileNames);
+    // Bind a column to its branch. A missing column is fatal if required, and left unbound otherwise.
+    void BindColumn(GasChamberStepStore::Column col, StepColumn &column, G4bool required);
+
+    private:
+    TChain fChain;
+    TTreeReader fReader;
+    std::array<GasChamberStepStore::ColumnStorage, GasChamberStepStore::kNbOfColumns> fStorage;
+    StepColumn fPosX, fPosY, fPosZ, fEdep, fTime;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
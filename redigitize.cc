@@ -0,0 +1,138 @@
+/// \file redigitize.cc
+/// \brief Main program re-digitizing the steps stored by sim_attpc
+
+#include "redigitize/StepTreeReader.hh"
+#include "redigitize/RedigitizeOutput.hh"
+#include "digitizer/DigitizerChain.hh"
+#include "config/ParamContainerTable.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+#include "CLHEP/Random/MixMaxRng.h"
+
+#include "TROOT.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LoadParameter(const G4String &paramFileName);
+
+int main(int argc, char **argv)
+{
+    // variables dependent to user inputs, given by the parameter file if not set
+    int nThreads = -1;
+    G4String paramFileName = "parameters/redigitize.txt";
+    G4String inputFile = "";
+    G4String outputFile = "";
+    for(int i = 1; i < argc;i += 2)
+    {
+        if(G4String(argv[i]) == "-t" && i + 1 < argc)
+            nThreads = atoi(argv[i + 1]);
+        else if(G4String(argv[i]) == "-p" && i + 1 < argc)
+            paramFileName = argv[i + 1];
+        else if(G4String(argv[i]) == "-i" && i + 1 < argc)
+            inputFile = argv[i + 1];
+        else if(G4String(argv[i]) == "-o" && i + 1 < argc)
+            outputFile = argv[i + 1];
+        else
+        {
+            if(G4String(argv[i]) != "--help")
+                G4cerr << "Invalid argument : " << argv[i] << G4endl;
+            G4cout << "Usage : ./redigitize [-t nThreads] [-p paramFile] [-i inputFiles] [-o outputFile]" << G4endl;
+            return -1;
+        }
+    }
+
+    // Load parameter files
+    LoadParameter(paramFileName);
+    const auto params = ParamContainerTable::GetContainer("redigitize");
+    const auto digitizerParams = ParamContainerTable::GetContainer("digitizer");
+    const auto padPlaneParams = ParamContainerTable::GetContainer("pad_plane");
+    if(inputFile.empty())
+        inputFile = params->GetParamS("inputFile");
+    if(outputFile.empty())
+        outputFile = params->GetParamS("outputFile");
+    if(nThreads < 0)
+        nThreads = params->GetParamI("nbOfThreads");
+    if(nThreads <= 0)
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    const long seed = params->GetParamI("seed");
+    const G4String storage = params->GetParamS("storage");
+    const G4double wValue = params->GetParamD("wValue")*eV;
+    // checked once here, rather than by every thread at every event.
+    if(digitizerParams->GetParamD("wValue") <= 0. && wValue <= 0.)
+        G4Exception("main()", "Redigitize0006", FatalException,
+            "Mean energy per ion pair is not set. Set wValue of the redigitize or digitizer parameters.");
+    OutputSettings outputSettings;
+    if(!outputSettings.SetCompression(params->GetParamS("compression")))
+        G4Exception("main()", "Redigitize0005", JustWarning,
+            ("Invalid compression " + params->GetParamS("compression") + ", the default is used.").c_str());
+    outputSettings.SetBasketSize(params->GetParamI("basketSize"));
+    outputSettings.SetAutoFlush(params->GetParamI("autoFlush"));
+
+    // every thread reads the input with its own files, and the output is filled under a lock.
+    ROOT::EnableThreadSafety();
+    const auto events = StepTreeReader::BuildIndex(inputFile);
+    G4cout << "Re-digitizing " << events.size() << " events of " << inputFile
+        << " with " << nThreads << " threads." << G4endl;
+    RedigitizeOutput output(outputFile, digitizerParams, outputSettings);
+
+    const auto start = std::chrono::steady_clock::now();
+    // Events are taken one by one by the threads, and the engine is seeded by the file and the id of the event,
+    // so the output of an event does not depend on the thread processing it.
+    std::atomic<std::size_t> nextEvent(0);
+    auto worker = [&]()
+    {
+        StepTreeReader reader(inputFile, storage);
+        DigitizerChain chain(digitizerParams, padPlaneParams);
+        // W-value of the digitizer parameter file overrides that of this program if positive.
+        if(chain.GetElectronDrift()->GetMeanEnergyPerIonPair() <= 0.)
+            chain.GetElectronDrift()->SetMeanEnergyPerIonPair(wValue);
+        DigitizerEvent event;
+        chain.InitEvent(event);
+        CLHEP::MixMaxRng engine;
+        for(std::size_t i = nextEvent++;i < events.size();i = nextEvent++)
+        {
+            event.Clear();
+            event.eventId = events[i].eventId;
+            reader.ReadEvent(events[i], event.steps);
+            const long seeds[3] = {seed, events[i].fileId, events[i].eventId};
+            engine.setSeeds(seeds, 3);
+            chain.Process(event, engine);
+            output.Fill(event, events[i].fileId);
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int i = 0;i < nThreads;++i)
+        threads.emplace_back(worker);
+    for(auto &thread : threads)
+        thread.join();
+    output.Close();
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    G4cout << events.size() << " events are written to " << outputFile
+        << " in " << elapsed.count() << " s." << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LoadParameter(const G4String &paramFileName)
+{
+    // The parameter files of the digitizer are given by the parameter file of this program,
+    // so it is read alone first, and the table is built again with all files.
+    ParamContainerTable::GetBuilder()->AddParamContainer("txt", "redigitize", paramFileName)->Build();
+    const auto params = ParamContainerTable::GetContainer("redigitize");
+    const G4String digitizerParams = params->GetParamS("digitizerParams");
+    const G4String padPlaneParams = params->GetParamS("padPlaneParams");
+    ParamContainerTable::GetBuilder()
+        ->AddParamContainer("txt", "redigitize", paramFileName)
+        ->AddParamContainer("txt", "digitizer", digitizerParams)
+        ->AddParamContainer("txt", "pad_plane", padPlaneParams)->Build();
+    ParamContainerTable::DumpTable();
+}
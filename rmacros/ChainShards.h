@@ -0,0 +1,35 @@
+#ifndef ChainShards_h
+#define ChainShards_h 1
+
+#include "TChain.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Chain a tree of the shards listed in the manifest of a run with /attpc/output/shards.
+// Each line of the manifest is : file thread nbOfEvents firstEvtId lastEvtId
+// Events of a shard are not consecutive, so events are to be selected by evtId.
+// Usage :
+//     TChain *chain = ChainShards("sim_attpc_shards.txt", "tree_gc2");
+TChain *ChainShards(const char *manifest, const char *treeName)
+{
+    std::string directory(manifest);
+    directory = directory.find('/') == std::string::npos ? "" : directory.substr(0, directory.rfind('/') + 1);
+
+    auto chain = new TChain(treeName);
+    std::ifstream file(manifest);
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+        std::istringstream ss(line);
+        std::string fileName;
+        ss >> fileName;
+        chain->Add((fileName[0] == '/' ? fileName : directory + fileName).c_str());
+    }
+    return chain;
+}
+
+#endif
@@ -0,0 +1,61 @@
+#include "TFile.h"
+#include "TTree.h"
+#include "TH1F.h"
+#include "TCanvas.h"
+#include "SparseWaveformReader.h"
+// To draw the readout waveform of a pad from tree_sparse of the digitizer output
+using namespace std;
+
+int DrawSparseWaveform(const char *fileName, int evtId = 0, int pad = -1, int nbOfBuckets = 512)
+{
+    auto fileRoot = new TFile(fileName, "READ");
+    SparseWaveformReader reader((TTree *)fileRoot->Get("tree_sparse"));
+
+    bool found = false;
+    while(reader.Next())
+    {
+        if(reader.GetEventId() == evtId)
+        {
+            found = true;
+            break;
+        }
+    }
+    if(!found || reader.GetNbOfPads() == 0)
+    {
+        cout << "No sample of event " << evtId << endl;
+        return -1;
+    }
+
+    int index = pad >= 0 ? reader.FindPad(pad) : 0;
+    if(index < 0)
+    {
+        cout << "No sample of pad " << pad << " in event " << evtId << endl;
+        return -1;
+    }
+    vector<float> waveform(nbOfBuckets);
+    // pad with the largest sample if not given
+    if(pad < 0)
+    {
+        float maxSample = 0;
+        for(int i = 0; i < reader.GetNbOfPads(); i++)
+        {
+            reader.GetWaveform(i, waveform.data(), nbOfBuckets);
+            float m = *max_element(waveform.begin(), waveform.end());
+            if(m > maxSample)
+            {
+                maxSample = m;
+                index = i;
+            }
+        }
+    }
+    reader.GetWaveform(index, waveform.data(), nbOfBuckets);
+
+    auto h = new TH1F("h", Form("pad %d of event %d;time bucket;adc", reader.GetPad(index), evtId),
+        nbOfBuckets, 0, nbOfBuckets);
+    for(int bucket = 0; bucket < nbOfBuckets; bucket++)
+        h->SetBinContent(bucket + 1, waveform[bucket]);
+    auto c1 = new TCanvas("c1", "c1", 900, 600);
+    h->Draw("HIST");
+
+    return 0;
+}
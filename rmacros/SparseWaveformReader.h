@@ -0,0 +1,102 @@
+#ifndef SparseWaveformReader_h
+#define SparseWaveformReader_h 1
+
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderArray.h"
+#include "TTreeReaderValue.h"
+
+#include <algorithm>
+#include <vector>
+
+// Reader of tree_sparse, the sparse pad-time layout of the readout samples written by the digitizer.
+// Pads of an event are sorted by pad id, and each pad has runs of consecutive samples read out,
+// one run of all buckets in the full and partial readout modes and runs above threshold in the zero mode.
+// Usage :
+//     SparseWaveformReader reader((TTree *)file->Get("tree_sparse"));
+//     std::vector<float> waveform(512);
+//     while(reader.Next())
+//         for(int i = 0; i < reader.GetNbOfPads(); i++)
+//             reader.GetWaveform(i, waveform.data(), waveform.size());
+class SparseWaveformReader
+{
+    public:
+    SparseWaveformReader(TTree *tree)
+        : reader(tree), evtId_(reader, "evtId"), pad_(reader, "pad"), nRange_(reader, "nRange"),
+        start_(reader, "start"), length_(reader, "length"), adc_(reader, "adc")
+    {}
+
+    bool Next()
+    {
+        if(!reader.Next())
+            return false;
+        Index();
+        return true;
+    }
+    bool SetEntry(Long64_t entry)
+    {
+        if(reader.SetEntry(entry) != TTreeReader::kEntryValid)
+            return false;
+        Index();
+        return true;
+    }
+
+    int GetEventId() { return *evtId_; }
+    int GetNbOfPads() { return pad_.GetSize(); }
+    int GetPad(int i) { return pad_[i]; }
+    // index of a pad in this event, -1 if it has no sample
+    int FindPad(int pad)
+    {
+        int lo = 0, hi = pad_.GetSize();
+        while(lo < hi)
+        {
+            int mid = (lo + hi)/2;
+            if(pad_[mid] < pad)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo < (int)pad_.GetSize() && pad_[lo] == pad ? lo : -1;
+    }
+    // runs of the i-th pad are firstRange[i] to firstRange[i + 1] - 1
+    int GetNbOfRanges(int i) { return firstRange[i + 1] - firstRange[i]; }
+    int GetRangeStart(int i, int j) { return start_[firstRange[i] + j]; }
+    int GetRangeLength(int i, int j) { return length_[firstRange[i] + j]; }
+    // samples of the j-th run of the i-th pad
+    const float *GetRangeSamples(int i, int j) { return &adc_[firstSample[firstRange[i] + j]]; }
+    // waveform of the i-th pad expanded to nbOfBuckets samples, zero out of its runs
+    void GetWaveform(int i, float *waveform, int nbOfBuckets)
+    {
+        std::fill(waveform, waveform + nbOfBuckets, 0.f);
+        for(int r = firstRange[i]; r < firstRange[i + 1]; r++)
+        {
+            const int end = std::min(start_[r] + length_[r], nbOfBuckets);
+            for(int bucket = start_[r], s = firstSample[r]; bucket < end; bucket++, s++)
+                waveform[bucket] = adc_[s];
+        }
+    }
+
+    private:
+    // offsets of the runs of pads and of the samples of runs
+    void Index()
+    {
+        const int nPad = pad_.GetSize(), nRange = start_.GetSize();
+        firstRange.resize(nPad + 1);
+        firstRange[0] = 0;
+        for(int i = 0; i < nPad; i++)
+            firstRange[i + 1] = firstRange[i] + nRange_[i];
+        firstSample.resize(nRange + 1);
+        firstSample[0] = 0;
+        for(int r = 0; r < nRange; r++)
+            firstSample[r + 1] = firstSample[r] + length_[r];
+    }
+
+    private:
+    TTreeReader reader;
+    TTreeReaderValue<int> evtId_;
+    TTreeReaderArray<int> pad_, nRange_, start_, length_;
+    TTreeReaderArray<float> adc_;
+    std::vector<int> firstRange, firstSample;
+};
+
+#endif
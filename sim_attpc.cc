@@ -97,6 +97,10 @@ int main(int argc, char **argv)
 
 void LoadParameter()
 {
-    ParamContainerTable::GetBuilder()->AddParamContainer("txt", "gas_chamber", "parameters/gas_chamber.txt")->Build();
+    ParamContainerTable::GetBuilder()
+        ->AddParamContainer("txt", "gas_chamber", "parameters/gas_chamber.txt")
+        ->AddParamContainer("txt", "ancillary", "parameters/ancillary.txt")
+        ->AddParamContainer("txt", "digitizer", "parameters/digitizer.txt")
+        ->AddParamContainer("txt", "pad_plane", "parameters/pad_plane.txt")->Build();
     ParamContainerTable::DumpTable();
 }
\ No newline at end of file
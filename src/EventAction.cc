@@ -3,7 +3,12 @@
 
 #include "EventAction.hh"
 #include "gas_chamber/GasChamberHit.hh"
+#include "gas_chamber/GasChamberTrackSummary.hh"
+#include "gas_chamber/GasChamberVoxelHit.hh"
 #include "AnalysisManager.hh"
+#include "analysis/AsyncNtupleWriter.hh"
+#include "config/ParamContainerTable.hh"
+#include "recorder/AncillaryRecorders.hh"
 
 #include "G4UnitsTable.hh"
 #include "G4Event.hh"
@@ -11,11 +16,15 @@
 #include "G4HCofThisEvent.hh"
 #include "G4VHitsCollection.hh"
 #include "G4SDManager.hh"
+#include "G4HCtable.hh"
+#include "G4DigiManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4ios.hh"
 
+#include <algorithm>
+
 // Utility function which finds a hit collection with the given Id
-// and print warnings if not found 
+// and print warnings if not found, unless its detector is switched off by /hits/inactivate.
 G4VHitsCollection *GetHC(const G4Event *event, G4int collId)
 {
     auto hce = event->GetHCofThisEvent();
@@ -31,6 +40,11 @@ G4VHitsCollection *GetHC(const G4Event *event, G4int collId)
     auto hc = hce->GetHC(collId);
     if(!hc)
     {
+        // inactive detectors make no hits collection.
+        auto sdManager = G4SDManager::GetSDMpointer();
+        const auto sd = sdManager->FindSensitiveDetector(sdManager->GetHCtable()->GetSDname(collId), false);
+        if(sd && !sd->isActive())
+            return nullptr;
         G4ExceptionDescription msg;
         msg << "Hits collection " << collId << " of this event not found." << G4endl;
         G4Exception("EventAction::EndOfEventAction()",
@@ -43,13 +57,32 @@ G4VHitsCollection *GetHC(const G4Event *event, G4int collId)
 
 EventAction::EventAction()
     : G4UserEventAction(),
-    verboseLevel(0), fHcIdsInitialized(false), fGasChamberHcId(-1)
+    verboseLevel(0), fHcIdsInitialized(false), fGasChamberHcId(-1), fGasChamberVoxelHcId(-1),
+    fVoxelIds(nullptr), fVoxelEdeps(nullptr), fDigitizer(nullptr), fDigitizerNtuple(nullptr),
+    fNbOfEvents(0), fFirstEventId(-1), fLastEventId(-1), fEventLayout(false),
+    fTrackIds(nullptr), fTrackNbOfSteps(nullptr), fTrackAtomicNumbers(nullptr), fStepOffsets(nullptr),
+    fTrackMasses(nullptr), fTrackLengths(nullptr), fTrackEdepSums(nullptr),
+    fWriteSummary(false), fSummaryVectors{}, fSummary(), fBookedStepColumns()
 {
     fVectorContainerD = new TupleVectorContainerD;
+    fVectorContainerF = new TupleVectorContainerF;
     fVectorContainerI = new TupleVectorContainerI;
 
     // initialize vector container for each tuple
     InitNtuplesVectorGasChamber();
+    InitNtuplesVectorGasChamberVoxel();
+
+    const auto ancillaryParams = ParamContainerTable::GetContainer("ancillary");
+    ForEachAncillaryRecorder([this, ancillaryParams](auto traits)
+    {
+        using Traits = decltype(traits);
+        if(ancillaryParams->GetParamB(Traits::kName))
+            fRecorderNtuples.push_back(new RecorderNtuple<Traits>);
+    });
+
+    const auto digitizerParams = ParamContainerTable::GetContainer("digitizer");
+    if(digitizerParams->GetParamB("enable"))
+        fDigitizerNtuple = new DigitizerNtuple(digitizerParams);
 
     // set printing per each event
     G4RunManager::GetRunManager()->SetPrintProgress(1);
@@ -61,7 +94,11 @@ EventAction::EventAction()
 EventAction::~EventAction()
 {
     delete fVectorContainerD;
+    delete fVectorContainerF;
     delete fVectorContainerI;
+    for(auto recorderNtuple : fRecorderNtuples)
+        delete recorderNtuple;
+    delete fDigitizerNtuple;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -72,20 +109,49 @@ void EventAction::BeginOfEventAction(const G4Event *)
     {
         fHcIdsInitialized = true;
         InitHcIds();
+        // only worker threads, which process events, need the digitizer.
+        if(fDigitizerNtuple)
+        {
+            fDigitizer = new GasChamberDigitizer;
+            G4DigiManager::GetDMpointer()->AddNewModule(fDigitizer);
+        }
     }
     PrintBeginOfEvent();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EventAction::EndOfEventAction(const G4Event *)
+void EventAction::EndOfEventAction(const G4Event *event)
 {
+    const G4int eventId = event->GetEventID();
+    if(fNbOfEvents++ == 0)
+        fFirstEventId = eventId;
+    fLastEventId = std::max(fLastEventId, eventId);
+    fFirstEventId = std::min(fFirstEventId, eventId);
+
     FillNtupleGasChamber();
+    FillNtupleGasChamberVoxel();
+    for(auto recorderNtuple : fRecorderNtuples)
+        recorderNtuple->Fill(event);
+    // digitization after the SDs have finished the event
+    if(fDigitizer)
+    {
+        G4DigiManager::GetDMpointer()->Digitize(fDigitizer->GetName());
+        fDigitizerNtuple->Fill(fDigitizer->GetEvent());
+    }
     PrintGasChamberHits();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void EventAction::ResetEventRange()
+{
+    fNbOfEvents = 0;
+    fFirstEventId = fLastEventId = -1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 vector<G4double> *EventAction::GetVectorPtrD(const std::string &tName, const std::string &vecName) const
 {
     return fVectorContainerD->GetVectorPtr(tName, vecName);
@@ -93,6 +159,13 @@ vector<G4double> *EventAction::GetVectorPtrD(const std::string &tName, const std
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+vector<G4float> *EventAction::GetVectorPtrF(const std::string &tName, const std::string &vecName) const
+{
+    return fVectorContainerF->GetVectorPtr(tName, vecName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 vector<G4int> *EventAction::GetVectorPtrI(const std::string &tName, const std::string &vecName) const
 {
     return fVectorContainerI->GetVectorPtr(tName, vecName);
@@ -102,8 +175,13 @@ vector<G4int> *EventAction::GetVectorPtrI(const std::string &tName, const std::s
 
 void EventAction::InitHcIds()
 {
+    // SDs disabled in parameters/gas_chamber.txt are not constructed, and their Ids are left -1.
     auto sdManager = G4SDManager::GetSDMpointer();
-    fGasChamberHcId = sdManager->GetCollectionID("gasChamber/GasChamberHColl");
+    const auto params = ParamContainerTable::GetContainer("gas_chamber");
+    if(params->GetParamB("recordSteps"))
+        fGasChamberHcId = sdManager->GetCollectionID("gasChamber/GasChamberHColl");
+    if(params->GetParamB("recordVoxels"))
+        fGasChamberVoxelHcId = sdManager->GetCollectionID("gasChamberVoxel/GasChamberVoxelHColl");
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -133,23 +211,111 @@ void EventAction::PrintBeginOfEvent()
 
 void EventAction::InitNtuplesVectorGasChamber()
 {
+    const auto params = ParamContainerTable::GetContainer("gas_chamber");
+    const auto layout = params->GetParamS("layout");
+    fEventLayout = layout == "event";
+    if(!fEventLayout && layout != "track")
+        G4Exception("EventAction::InitNtuplesVectorGasChamber()", "EventAction0000", JustWarning,
+            ("Unknown layout " + layout + " of tree_gc2, track layout is used.").c_str());
+    // step columns are still recorded by the SD for the summaries if they are not written.
+    const auto summary = params->GetParamS("trackSummary");
+    fWriteSummary = summary == "on" || summary == "only";
+    if(!fWriteSummary && summary != "off")
+        G4Exception("EventAction::InitNtuplesVectorGasChamber()", "EventAction0001", JustWarning,
+            ("Unknown trackSummary " + summary + ", track summaries are not written.").c_str());
+    const auto recordedColumns = GasChamberStepStore::ParseColumns(params->GetParamS("columns"));
+    if(fWriteSummary)
+    {
+        if(!recordedColumns.test(GasChamberStepStore::kPosX) || !recordedColumns.test(GasChamberStepStore::kPosY)
+            || !recordedColumns.test(GasChamberStepStore::kPosZ) || !recordedColumns.test(GasChamberStepStore::kEdep))
+            G4Exception("EventAction::InitNtuplesVectorGasChamber()", "EventAction0002", JustWarning,
+                "Track summaries need x, y, z and eDep in columns, and are zero without them.");
+    }
+    if(summary != "only")
+        fBookedStepColumns = GasChamberStepStore::ToColumnList(recordedColumns);
+
+    // every step column can be stored as double, float or fixed point integer.
     fVectorContainerD->AddTuple("tree_gc2");
-    fVectorContainerD->AddVectors("tree_gc2",
-        {"x", "y", "z", "px", "py", "pz", "eDep", "t", "q", "stepLen"});
-    fVectorContainerD->ReserveAll("tree_gc2", 5000);
+    fVectorContainerF->AddTuple("tree_gc2");
+    fVectorContainerI->AddTuple("tree_gc2");
+    for(G4int col = 0;col < GasChamberStepStore::kNbOfColumns;++col)
+    {
+        const auto &name = GasChamberStepStore::GetColumnName(static_cast<GasChamberStepStore::Column>(col));
+        fVectorContainerD->AddVector("tree_gc2", name);
+        fVectorContainerF->AddVector("tree_gc2", name);
+        fVectorContainerI->AddVector("tree_gc2", name);
+    }
+
+    // per-track arrays of the event layout
+    if(fEventLayout)
+    {
+        fVectorContainerI->AddVectors("tree_gc2", {"trkId", "Nstep", "atomNum", "stepOffset"});
+        fVectorContainerD->AddVectors("tree_gc2", {"mass", "trkLen", "eDepSum"});
+        fTrackIds = GetVectorPtrI("tree_gc2", "trkId");
+        fTrackNbOfSteps = GetVectorPtrI("tree_gc2", "Nstep");
+        fTrackAtomicNumbers = GetVectorPtrI("tree_gc2", "atomNum");
+        fStepOffsets = GetVectorPtrI("tree_gc2", "stepOffset");
+        fTrackMasses = GetVectorPtrD("tree_gc2", "mass");
+        fTrackLengths = GetVectorPtrD("tree_gc2", "trkLen");
+        fTrackEdepSums = GetVectorPtrD("tree_gc2", "eDepSum");
+        for(G4int i = 0;fWriteSummary && i < GasChamberTrackSummary::kNbOfValues;++i)
+        {
+            const auto name = GasChamberTrackSummary::GetColumnName(static_cast<GasChamberTrackSummary::Value>(i));
+            fVectorContainerD->AddVector("tree_gc2", name);
+            fSummaryVectors[i] = GetVectorPtrD("tree_gc2", name);
+        }
+    }
+
+    // Columns booked in tree_gc2 by RunAction::CreateTuplesGasChamber().
+    // In the track layout, their buffers are swapped with those of the hits, so they are not reserved.
+    // In the event layout, the steps of all tracks are appended to them.
+    for(auto col : fBookedStepColumns)
+    {
+        const auto &name = GasChamberStepStore::GetColumnName(col);
+        switch(GasChamberStepStore::GetColumnStorage(col).type)
+        {
+            case GasChamberStepStore::kFloat:
+                fGasChamberStepVectorsF.emplace_back(col, GetVectorPtrF("tree_gc2", name));
+                break;
+            case GasChamberStepStore::kFixedPoint:
+                fGasChamberStepVectorsI.emplace_back(col, GetVectorPtrI("tree_gc2", name));
+                break;
+            default:
+                fGasChamberStepVectors.emplace_back(col, GetVectorPtrD("tree_gc2", name));
+        }
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void EventAction::FillNtupleGasChamber()
 {
+    if(fGasChamberHcId < 0)
+        return;
     auto hitCol = GetHC(G4RunManager::GetRunManager()->GetCurrentEvent(), fGasChamberHcId);
+    if(!hitCol)
+        return;
+    if(fEventLayout)
+        FillEventLayoutVectors(hitCol);
+    if(AsyncNtupleWriter::GetInstance()->IsOpen())
+    {
+        FillNtupleGasChamberAsync(hitCol);
+        return;
+    }
     auto analysisManager = G4AnalysisManager::Instance();
 
     // tuple saved by event
     analysisManager->FillNtupleIColumn(0, 0, hitCol->GetSize());
     analysisManager->AddNtupleRow(0);
 
+    if(fEventLayout)
+    {
+        analysisManager->FillNtupleIColumn(1, 0, G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID());
+        analysisManager->FillNtupleIColumn(1, 1, hitCol->GetSize());
+        analysisManager->AddNtupleRow(1);
+        return;
+    }
+
     // tuple saved by track
     for(size_t i = 0;i < hitCol->GetSize();++i)
     {
@@ -162,30 +328,199 @@ void EventAction::FillNtupleGasChamber()
         analysisManager->FillNtupleDColumn(1, 5, hit->GetTrackLength());
         analysisManager->FillNtupleDColumn(1, 6, hit->GetEdepSum());
         // analysisManager->FillNtupleSColumn(1, 7, hit->GetPartName());
+        if(fWriteSummary)
+        {
+            fSummary.Compute(*hit);
+            for(G4int k = 0;k < GasChamberTrackSummary::kNbOfValues;++k)
+                analysisManager->FillNtupleDColumn(1, 7 + k, fSummary.values[k]);
+        }
 
         // vector part
-        *GetVectorPtrD("tree_gc2", "x") = hit->GetPosX();
-        *GetVectorPtrD("tree_gc2", "y") = hit->GetPosY();
-        *GetVectorPtrD("tree_gc2", "z") = hit->GetPosZ();
-        *GetVectorPtrD("tree_gc2", "px") = hit->GetMomX();
-        *GetVectorPtrD("tree_gc2", "py") = hit->GetMomY();
-        *GetVectorPtrD("tree_gc2", "pz") = hit->GetMomZ();
-        *GetVectorPtrD("tree_gc2", "eDep") = hit->GetEdep();
-        // *GetVectorPtrD("tree_gc2", "t") = hit->GetTime();
-        // *GetVectorPtrD("tree_gc2", "q") = hit->GetCharge();
-        *GetVectorPtrD("tree_gc2", "stepLen") = hit->GetStepLen();
+        // The step buffers of the hit are lent to the ntuple columns for the row,
+        // so step data are not copied until they are written to the basket.
+        // Columns not recorded by the SD are written as empty vectors.
+        auto swapStepColumns = [hit](auto &stepVectors)
+        {
+            for(auto &col : stepVectors)
+                hit->SwapStepColumn(col.first, *col.second);
+        };
+        swapStepColumns(fGasChamberStepVectors);
+        swapStepColumns(fGasChamberStepVectorsF);
+        swapStepColumns(fGasChamberStepVectorsI);
         analysisManager->AddNtupleRow(1);
-        fVectorContainerD->ClearAll("tree_gc2");
+        swapStepColumns(fGasChamberStepVectors);
+        swapStepColumns(fGasChamberStepVectorsF);
+        swapStepColumns(fGasChamberStepVectorsI);
     }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EventAction::PrintGasChamberHits()
+void EventAction::FillEventLayoutVectors(G4VHitsCollection *hitCol)
 {
+    // Tracks of the event are concatenated, and the steps of the i-th track are
+    // stepOffset[i] to stepOffset[i + 1] - 1 of the step arrays.
+    const size_t nbOfTracks = hitCol->GetSize();
+    for(auto vec : {fTrackIds, fTrackNbOfSteps, fTrackAtomicNumbers, fStepOffsets})
+    {
+        vec->clear();
+        vec->reserve(nbOfTracks + 1);
+    }
+    for(auto vec : {fTrackMasses, fTrackLengths, fTrackEdepSums})
+    {
+        vec->clear();
+        vec->reserve(nbOfTracks);
+    }
+    for(auto vec : fSummaryVectors)
+        if(vec)
+            vec->clear();
+    auto clearStepVectors = [](auto &stepVectors)
+    {
+        for(auto &col : stepVectors)
+            col.second->clear();
+    };
+    clearStepVectors(fGasChamberStepVectors);
+    clearStepVectors(fGasChamberStepVectorsF);
+    clearStepVectors(fGasChamberStepVectorsI);
+
+    G4int nbOfSteps = 0;
+    fStepOffsets->push_back(0);
+    for(size_t i = 0;i < nbOfTracks;++i)
+    {
+        auto hit = static_cast<GasChamberHit *>(hitCol->GetHit(i));
+        fTrackIds->push_back(hit->GetTrackId());
+        fTrackNbOfSteps->push_back(hit->GetNbOfStepPoints());
+        fTrackAtomicNumbers->push_back(hit->GetAtomicNumber());
+        fTrackMasses->push_back(hit->GetMass());
+        fTrackLengths->push_back(hit->GetTrackLength());
+        fTrackEdepSums->push_back(hit->GetEdepSum());
+        if(fWriteSummary)
+        {
+            fSummary.Compute(*hit);
+            for(G4int k = 0;k < GasChamberTrackSummary::kNbOfValues;++k)
+                fSummaryVectors[k]->push_back(fSummary.values[k]);
+        }
+        nbOfSteps += hit->GetNbOfStepPoints();
+        fStepOffsets->push_back(nbOfSteps);
+
+        auto appendStepColumns = [hit](auto &stepVectors)
+        {
+            for(auto &col : stepVectors)
+                hit->AppendStepColumn(col.first, *col.second);
+        };
+        appendStepColumns(fGasChamberStepVectors);
+        appendStepColumns(fGasChamberStepVectorsF);
+        appendStepColumns(fGasChamberStepVectorsI);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::FillNtupleGasChamberAsync(G4VHitsCollection *hitCol)
+{
+    // The rows are copied into a record for the writer thread, since the digitizer
+    // and the printing still read the hits after the ntuples are filled.
+    auto writer = AsyncNtupleWriter::GetInstance();
+    auto record = writer->AcquireRecord();
+    record->AddRow(0).ints.push_back(hitCol->GetSize());
+    const G4int eventId = G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID();
+    if(fEventLayout)
+    {
+        // The vectors of the row follow the order of booking by type in RunAction::CreateTuplesGasChamberAsync().
+        auto &row = record->AddRow(1);
+        row.ints.insert(row.ints.end(), {eventId, static_cast<G4int>(hitCol->GetSize())});
+        auto copyVectors = [](const auto &vectors, auto &rowVectors)
+        {
+            rowVectors.resize(vectors.size());
+            for(size_t k = 0;k < vectors.size();++k)
+                rowVectors[k].assign(vectors[k]->begin(), vectors[k]->end());
+        };
+        std::vector<const vector<G4int> *> intVectors{fTrackIds, fTrackNbOfSteps, fTrackAtomicNumbers, fStepOffsets};
+        std::vector<const vector<G4double> *> doubleVectors{fTrackMasses, fTrackLengths, fTrackEdepSums};
+        std::vector<const vector<G4float> *> floatVectors;
+        if(fWriteSummary)
+            doubleVectors.insert(doubleVectors.end(), fSummaryVectors.begin(), fSummaryVectors.end());
+        for(const auto &col : fGasChamberStepVectorsI)
+            intVectors.push_back(col.second);
+        for(const auto &col : fGasChamberStepVectors)
+            doubleVectors.push_back(col.second);
+        for(const auto &col : fGasChamberStepVectorsF)
+            floatVectors.push_back(col.second);
+        copyVectors(intVectors, row.intVectors);
+        copyVectors(doubleVectors, row.doubleVectors);
+        copyVectors(floatVectors, row.floatVectors);
+        writer->Push(record);
+        return;
+    }
+    for(size_t i = 0;i < hitCol->GetSize();++i)
+    {
+        auto hit = static_cast<GasChamberHit *>(hitCol->GetHit(i));
+        auto &row = record->AddRow(1);
+        row.ints.insert(row.ints.end(), {eventId, hit->GetTrackId(), hit->GetNbOfStepPoints(), hit->GetAtomicNumber()});
+        row.doubles.insert(row.doubles.end(), {hit->GetMass(), hit->GetTrackLength(), hit->GetEdepSum()});
+        if(fWriteSummary)
+        {
+            fSummary.Compute(*hit);
+            row.doubles.insert(row.doubles.end(), fSummary.values.begin(), fSummary.values.end());
+        }
+        auto copyStepColumns = [hit](const auto &stepVectors, auto &rowVectors)
+        {
+            rowVectors.resize(stepVectors.size());
+            for(size_t k = 0;k < stepVectors.size();++k)
+                hit->CopyStepColumn(stepVectors[k].first, rowVectors[k]);
+        };
+        copyStepColumns(fGasChamberStepVectors, row.doubleVectors);
+        copyStepColumns(fGasChamberStepVectorsF, row.floatVectors);
+        copyStepColumns(fGasChamberStepVectorsI, row.intVectors);
+    }
+    writer->Push(record);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::InitNtuplesVectorGasChamberVoxel()
+{
+    fVectorContainerI->AddTuple("tree_gc3");
+    fVectorContainerI->AddVector("tree_gc3", "voxel");
+    fVectorContainerF->AddTuple("tree_gc3");
+    fVectorContainerF->AddVector("tree_gc3", "eDep");
+    fVoxelIds = GetVectorPtrI("tree_gc3", "voxel");
+    fVoxelEdeps = GetVectorPtrF("tree_gc3", "eDep");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::FillNtupleGasChamberVoxel()
+{
+    if(fGasChamberVoxelHcId < 0)
+        return;
+    auto hitCol = GetHC(G4RunManager::GetRunManager()->GetCurrentEvent(), fGasChamberVoxelHcId);
+    if(!hitCol || hitCol->GetSize() == 0)
+        return;
+
+    // one hit per event holding the voxel map
+    auto hit = static_cast<GasChamberVoxelHit *>(hitCol->GetHit(0));
+    const auto voxelMap = hit->GetVoxelMap();
+    fVoxelIds->assign(voxelMap->GetVoxelIds().begin(), voxelMap->GetVoxelIds().end());
+    fVoxelEdeps->assign(voxelMap->GetEdeps().begin(), voxelMap->GetEdeps().end());
+
+    auto analysisManager = G4AnalysisManager::Instance();
+    analysisManager->FillNtupleIColumn(2, 0, hit->GetEventId());
+    analysisManager->FillNtupleDColumn(2, 1, hit->GetEdepOutside());
+    analysisManager->AddNtupleRow(2);
     if(verboseLevel > 0)
+        hit->Print();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::PrintGasChamberHits()
+{
+    if(verboseLevel > 0 && fGasChamberHcId >= 0)
     {
         auto hitCol = GetHC(G4RunManager::GetRunManager()->GetCurrentEvent(), fGasChamberHcId);
+        if(!hitCol)
+            return;
         int prec = G4cout.precision(4);
         G4cout << "--------------------------------------------------------------------------------------------------------------------------------" << G4endl;
         G4cout << std::setw(40) << std::left << "The # of tracks in this event" << " : " << std::setw(10) << std::right << hitCol->GetSize() << G4endl;
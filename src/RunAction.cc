@@ -3,28 +3,41 @@
 
 #include "RunAction.hh"
 #include "EventAction.hh"
+#include "analysis/AsyncNtupleWriter.hh"
+#include "analysis/ShardManifest.hh"
+#include "gas_chamber/GasChamberStepStore.hh"
+#include "config/ParamContainerTable.hh"
 
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4UIcommand.hh"
+
+#include "TROOT.h"
+
+#include <chrono>
+#include <sstream>
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 RunAction::RunAction(EventAction *eventAction)
     : G4UserRunAction(),
-    fAnaActivated(false), fFileName("sim_attpc.root"),
+    fAnaActivated(false), fFileName("sim_attpc.root"), fAsyncOutput(false), fAsyncQueueSize(64),
+    fShardOutput(false), fOutputSettings(), fNtupleOutputSettings(),
     fEventAction(eventAction), fAnalysisManager(nullptr)
 {
     // it is recommened that analysis manager instance be created in user run action constructor.
     fAnalysisManager = G4AnalysisManager::Instance();
     fAnalysisManager->SetVerboseLevel(1);
-    // If running in MT, merge all tuples after the end of run.
-    fAnalysisManager->SetNtupleMerging(true);
     
     // creating ntuples
     // why tuples must be created in constructor of user RunAction class, not in RunAction::BeginOfRunAction?
     CreateTuplesGasChamber();
     fAnalysisManager->FinishNtuple();
+    CreateTuplesAncillary();
+    if(fEventAction->GetDigitizerNtuple())
+        fEventAction->GetDigitizerNtuple()->Book();
 
     DefineCommands();
 }
@@ -40,8 +53,36 @@ RunAction::~RunAction()
 
 void RunAction::BeginOfRunAction(const G4Run * /*run*/)
 {
+    // In the asynchronous mode, the step ntuples are deactivated in the file of the analysis manager,
+    // and the master opens the writer before workers start events.
+    const G4bool async = fAnaActivated && fAsyncOutput;
+    // The steps file of the asynchronous writer is written by the master and is not a shard of any thread,
+    // so the manifest could not list the steps of the run.
+    if(async && fShardOutput && IsMaster())
+        G4Exception("RunAction::BeginOfRunAction(const G4Run *)", "RunAction0003", FatalErrorInArgument,
+            "/attpc/output/async and /attpc/output/shards cannot be used together, since tree_gc1 and tree_gc2 "
+            "would be written to the steps file of the master, which is not listed in the shard manifest.");
+    fAnalysisManager->SetNtupleActivation(0, !async);
+    fAnalysisManager->SetNtupleActivation(1, !async);
+    // If running in MT, merge all tuples after the end of run, unless each worker writes its own shard.
+    // The merging mode is fixed when the ntuples are created at the first run.
+    fAnalysisManager->SetNtupleMerging(!fShardOutput);
+    ApplyOutputSettings(async);
     fAnalysisManager->SetActivation(fAnaActivated);
     fAnalysisManager->OpenFile(fFileName);
+    fEventAction->ResetEventRange();
+    if(IsMaster())
+    {
+        ShardManifest::GetInstance()->Clear();
+        // Worker threads read their files back with ROOT for the compression report.
+        ROOT::EnableThreadSafety();
+    }
+
+    if(async && IsMaster())
+    {
+        CreateTuplesGasChamberAsync();
+        AsyncNtupleWriter::GetInstance()->Open(GetFileStem() + "_steps.root", fAsyncQueueSize);
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -50,9 +91,186 @@ void RunAction::EndOfRunAction(const G4Run * /*run*/)
 {
     // save histograms & ntuple
     //
+    const auto start = std::chrono::steady_clock::now();
     if(fAnalysisManager->GetActivation())
         fAnalysisManager->Write();
     fAnalysisManager->CloseFile();
+    const G4double closeTime = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+    if(fAnaActivated && HasNtupleRows())
+    {
+        // Baskets filled during the run are compressed as they are full, so this time covers
+        // the remaining baskets and the merging of workers only, not the whole compression.
+        const auto fileName = GetThreadFileName();
+        OutputSettings::PrintCompression(fileName, OutputSettings::GetTreeSizes(fileName), closeTime,
+            "writing the last baskets and closing the file");
+    }
+    if(fAnaActivated && fShardOutput)
+        AddShard();
+    // workers have finished their events when the master ends the run.
+    if(IsMaster())
+        AsyncNtupleWriter::GetInstance()->Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String RunAction::GetFileStem() const
+{
+    G4String stem = fFileName;
+    if(stem.size() > 5 && stem.substr(stem.size() - 5) == ".root")
+        stem.erase(stem.size() - 5);
+    return stem;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool RunAction::HasNtupleRows() const
+{
+    if(!G4Threading::IsMultithreadedApplication())
+        return true;
+    return IsMaster() ? !fShardOutput : fShardOutput;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String RunAction::GetThreadFileName() const
+{
+    // the file names of workers given by G4AnalysisManager when ntuples are not merged
+    if(IsMaster())
+        return GetFileStem() + ".root";
+    return GetFileStem() + "_t" + std::to_string(G4Threading::G4GetThreadId()) + ".root";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::AddShard()
+{
+    // The master of a multithreaded run has no event, and its file has no ntuple row.
+    // Workers end their runs before the master, so the manifest is complete when the master writes it.
+    auto manifest = ShardManifest::GetInstance();
+    if(HasNtupleRows())
+    {
+        ShardManifest::Shard shard;
+        shard.fileName = GetThreadFileName();
+        shard.threadId = IsMaster() ? 0 : G4Threading::G4GetThreadId();
+        shard.nbOfEvents = fEventAction->GetNbOfEvents();
+        shard.firstEventId = fEventAction->GetFirstEventId();
+        shard.lastEventId = fEventAction->GetLastEventId();
+        manifest->AddShard(shard);
+    }
+    if(IsMaster())
+        manifest->Write(GetFileStem() + "_shards.txt");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::ApplyOutputSettings(G4bool async)
+{
+    // The file of G4AnalysisManager is written by the Geant4 ROOT writer and not by ROOT, so neither its file
+    // nor its trees can be given ROOT settings. It compresses with zlib only and has one basket size
+    // for all ntuples. The other settings apply to the asynchronous output, which is written with ROOT.
+    if(fOutputSettings.HasCompression())
+        fAnalysisManager->SetCompressionLevel(fOutputSettings.GetLevel());
+    if(fOutputSettings.GetBasketSize() > 0)
+        fAnalysisManager->SetBasketSize(fOutputSettings.GetBasketSize());
+    if(!IsMaster())
+        return;
+    if(async)
+        AsyncNtupleWriter::GetInstance()->SetOutputSettings(fOutputSettings, fNtupleOutputSettings);
+    else if(fOutputSettings.GetAutoFlush() != 0)
+        G4Exception("RunAction::ApplyOutputSettings(G4bool)", "RunAction0002", JustWarning,
+            "autoFlush is not applied, since only ntuples of the asynchronous output (tree_gc1, tree_gc2) are written with ROOT.");
+    for(const auto &ntupleSettings : fNtupleOutputSettings)
+    {
+        if(async && (ntupleSettings.first == "tree_gc1" || ntupleSettings.first == "tree_gc2"))
+            continue;
+        std::ostringstream message;
+        message << "Settings of " << ntupleSettings.first << " are not applied, "
+            << "since only ntuples of the asynchronous output (tree_gc1, tree_gc2) are written with ROOT.";
+        G4Exception("RunAction::ApplyOutputSettings(G4bool)", "RunAction0002", JustWarning, message);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetCompression(const G4String &compression)
+{
+    OutputSettings settings = fOutputSettings;
+    if(!settings.SetCompression(compression))
+    {
+        G4Exception("RunAction::SetCompression(const G4String &)", "RunAction0000", JustWarning,
+            ("Invalid compression " + compression + ", expected <zlib|lzma|lz4|zstd>:<level>, none or default.").c_str());
+        return;
+    }
+    // The Geant4 ROOT writer of the main file cannot compress with the other algorithms.
+    if(settings.HasCompression() && settings.GetAlgorithm() != OutputSettings::kZLIB)
+    {
+        G4Exception("RunAction::SetCompression(const G4String &)", "RunAction0001", JustWarning,
+            ("Compression " + compression + " is not applied, since the file of G4AnalysisManager can be compressed with zlib only. "
+            "Use /attpc/output/ntupleCompression for the ntuples of the asynchronous output.").c_str());
+        return;
+    }
+    fOutputSettings = settings;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetBasketSize(G4int basketSize)
+{
+    fOutputSettings.SetBasketSize(basketSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetAutoFlush(G4int autoFlush)
+{
+    fOutputSettings.SetAutoFlush(autoFlush);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Split "<ntuple>,<value>" of the commands of ntuple settings.
+static G4bool SplitNtupleSetting(const G4String &setting, G4String &ntupleName, G4String &value)
+{
+    const auto comma = setting.find(',');
+    if(comma == std::string::npos || comma == 0 || comma + 1 == setting.size())
+    {
+        G4Exception("SplitNtupleSetting(const G4String &, G4String &, G4String &)", "RunAction0000", JustWarning,
+            ("Invalid ntuple setting " + setting + ", expected <ntuple>,<value>.").c_str());
+        return false;
+    }
+    ntupleName = setting.substr(0, comma);
+    value = setting.substr(comma + 1);
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetNtupleCompression(const G4String &ntupleCompression)
+{
+    G4String ntupleName, compression;
+    if(!SplitNtupleSetting(ntupleCompression, ntupleName, compression))
+        return;
+    if(!fNtupleOutputSettings[ntupleName].SetCompression(compression))
+        G4Exception("RunAction::SetNtupleCompression(const G4String &)", "RunAction0000", JustWarning,
+            ("Invalid compression " + compression + ", expected <zlib|lzma|lz4|zstd>:<level>, none or default.").c_str());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetNtupleBasketSize(const G4String &ntupleBasketSize)
+{
+    G4String ntupleName, basketSize;
+    if(SplitNtupleSetting(ntupleBasketSize, ntupleName, basketSize))
+        fNtupleOutputSettings[ntupleName].SetBasketSize(G4UIcommand::ConvertToInt(basketSize.c_str()));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetNtupleAutoFlush(const G4String &ntupleAutoFlush)
+{
+    G4String ntupleName, autoFlush;
+    if(SplitNtupleSetting(ntupleAutoFlush, ntupleName, autoFlush))
+        fNtupleOutputSettings[ntupleName].SetAutoFlush(G4UIcommand::ConvertToInt(autoFlush.c_str()));
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -62,27 +280,129 @@ void RunAction::CreateTuplesGasChamber()
     fAnalysisManager->CreateNtuple("tree_gc1", "gas chamber hit data saved by event");
     fAnalysisManager->CreateNtupleIColumn("Ntrk"); // 0 0
 
-    fAnalysisManager->CreateNtuple("tree_gc2", "gas chamber hit data saved by trk");
-    fAnalysisManager->CreateNtupleIColumn("evtId"); // 1 0
-    fAnalysisManager->CreateNtupleIColumn("trkId"); // 1 1
-    fAnalysisManager->CreateNtupleIColumn("Nstep"); // 1 2
-    fAnalysisManager->CreateNtupleIColumn("atomNum"); // 1 3
-    fAnalysisManager->CreateNtupleDColumn("mass"); // 1 4
-    fAnalysisManager->CreateNtupleDColumn("trkLen"); // 1 5
-    fAnalysisManager->CreateNtupleDColumn("eDepSum"); // 1 6
-    // fAnalysisManager->CreateNtupleSColumn("part"); // 1 7
+    if(fEventAction->IsEventLayout())
+    {
+        // one row per event with the columns of tracks as arrays
+        fAnalysisManager->CreateNtuple("tree_gc2", "gas chamber hit data saved by event");
+        fAnalysisManager->CreateNtupleIColumn("evtId"); // 1 0
+        fAnalysisManager->CreateNtupleIColumn("Ntrk"); // 1 1
+        for(auto name : {"trkId", "Nstep", "atomNum", "stepOffset"})
+            fAnalysisManager->CreateNtupleIColumn(name, *fEventAction->GetVectorPtrI("tree_gc2", name));
+        for(auto name : {"mass", "trkLen", "eDepSum"})
+            fAnalysisManager->CreateNtupleDColumn(name, *fEventAction->GetVectorPtrD("tree_gc2", name));
+        for(G4int i = 0;fEventAction->HasTrackSummary() && i < GasChamberTrackSummary::kNbOfValues;++i)
+        {
+            const auto name = GasChamberTrackSummary::GetColumnName(static_cast<GasChamberTrackSummary::Value>(i));
+            fAnalysisManager->CreateNtupleDColumn(name, *fEventAction->GetVectorPtrD("tree_gc2", name));
+        }
+    }
+    else
+    {
+        fAnalysisManager->CreateNtuple("tree_gc2", "gas chamber hit data saved by trk");
+        fAnalysisManager->CreateNtupleIColumn("evtId"); // 1 0
+        fAnalysisManager->CreateNtupleIColumn("trkId"); // 1 1
+        fAnalysisManager->CreateNtupleIColumn("Nstep"); // 1 2
+        fAnalysisManager->CreateNtupleIColumn("atomNum"); // 1 3
+        fAnalysisManager->CreateNtupleDColumn("mass"); // 1 4
+        fAnalysisManager->CreateNtupleDColumn("trkLen"); // 1 5
+        fAnalysisManager->CreateNtupleDColumn("eDepSum"); // 1 6
+        // fAnalysisManager->CreateNtupleSColumn("part"); // 1 7
+        // track summaries // 1 7 to 1 12
+        for(G4int i = 0;fEventAction->HasTrackSummary() && i < GasChamberTrackSummary::kNbOfValues;++i)
+            fAnalysisManager->CreateNtupleDColumn(
+                GasChamberTrackSummary::GetColumnName(static_cast<GasChamberTrackSummary::Value>(i)));
+    }
     
     // vector part
-    fAnalysisManager->CreateNtupleDColumn("x", *fEventAction->GetVectorPtrD("tree_gc2", "x"));
-    fAnalysisManager->CreateNtupleDColumn("y", *fEventAction->GetVectorPtrD("tree_gc2", "y"));
-    fAnalysisManager->CreateNtupleDColumn("z", *fEventAction->GetVectorPtrD("tree_gc2", "z"));
-    fAnalysisManager->CreateNtupleDColumn("px", *fEventAction->GetVectorPtrD("tree_gc2", "px"));
-    fAnalysisManager->CreateNtupleDColumn("py", *fEventAction->GetVectorPtrD("tree_gc2", "py"));
-    fAnalysisManager->CreateNtupleDColumn("pz", *fEventAction->GetVectorPtrD("tree_gc2", "pz"));
-    fAnalysisManager->CreateNtupleDColumn("eDep", *fEventAction->GetVectorPtrD("tree_gc2", "eDep"));
-    // fAnalysisManager->CreateNtupleDColumn("t", *fEventAction->GetVectorPtrD("tree_gc2", "t"));
-    // fAnalysisManager->CreateNtupleDColumn("q", *fEventAction->GetVectorPtrD("tree_gc2", "q"));
-    fAnalysisManager->CreateNtupleDColumn("stepLen", *fEventAction->GetVectorPtrD("tree_gc2", "stepLen"));
+    // only the step columns selected in the parameter file are booked, with their storage type.
+    for(auto col : fEventAction->GetBookedStepColumns())
+    {
+        const auto &name = GasChamberStepStore::GetColumnName(col);
+        switch(GasChamberStepStore::GetColumnStorage(col).type)
+        {
+            case GasChamberStepStore::kFloat:
+                fAnalysisManager->CreateNtupleFColumn(name, *fEventAction->GetVectorPtrF("tree_gc2", name));
+                break;
+            case GasChamberStepStore::kFixedPoint:
+                fAnalysisManager->CreateNtupleIColumn(name, *fEventAction->GetVectorPtrI("tree_gc2", name));
+                break;
+            default:
+                fAnalysisManager->CreateNtupleDColumn(name, *fEventAction->GetVectorPtrD("tree_gc2", name));
+        }
+    }
+
+    // voxel energy deposits, booked only if the voxel SD is enabled.
+    if(ParamContainerTable::GetContainer("gas_chamber")->GetParamB("recordVoxels"))
+    {
+        fAnalysisManager->CreateNtuple("tree_gc3", "gas chamber energy deposit saved by occupied voxel");
+        fAnalysisManager->CreateNtupleIColumn("evtId"); // 2 0
+        fAnalysisManager->CreateNtupleDColumn("eDepOut"); // 2 1
+        fAnalysisManager->CreateNtupleIColumn("voxel", *fEventAction->GetVectorPtrI("tree_gc3", "voxel")); // 2 2
+        fAnalysisManager->CreateNtupleFColumn("eDep", *fEventAction->GetVectorPtrF("tree_gc3", "eDep")); // 2 3
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::CreateTuplesGasChamberAsync()
+{
+    auto writer = AsyncNtupleWriter::GetInstance();
+    writer->ClearNtuples();
+    auto gc1 = writer->CreateNtuple("tree_gc1", "gas chamber hit data saved by event");
+    writer->CreateColumn(gc1, "Ntrk", AsyncNtupleWriter::kInt);
+
+    G4int gc2;
+    if(fEventAction->IsEventLayout())
+    {
+        gc2 = writer->CreateNtuple("tree_gc2", "gas chamber hit data saved by event");
+        writer->CreateColumn(gc2, "evtId", AsyncNtupleWriter::kInt);
+        writer->CreateColumn(gc2, "Ntrk", AsyncNtupleWriter::kInt);
+        for(auto name : {"trkId", "Nstep", "atomNum", "stepOffset"})
+            writer->CreateColumn(gc2, name, AsyncNtupleWriter::kIntVector);
+        for(auto name : {"mass", "trkLen", "eDepSum"})
+            writer->CreateColumn(gc2, name, AsyncNtupleWriter::kDoubleVector);
+        for(G4int i = 0;fEventAction->HasTrackSummary() && i < GasChamberTrackSummary::kNbOfValues;++i)
+            writer->CreateColumn(gc2, GasChamberTrackSummary::GetColumnName(static_cast<GasChamberTrackSummary::Value>(i)),
+                AsyncNtupleWriter::kDoubleVector);
+    }
+    else
+    {
+        gc2 = writer->CreateNtuple("tree_gc2", "gas chamber hit data saved by trk");
+        writer->CreateColumn(gc2, "evtId", AsyncNtupleWriter::kInt);
+        writer->CreateColumn(gc2, "trkId", AsyncNtupleWriter::kInt);
+        writer->CreateColumn(gc2, "Nstep", AsyncNtupleWriter::kInt);
+        writer->CreateColumn(gc2, "atomNum", AsyncNtupleWriter::kInt);
+        writer->CreateColumn(gc2, "mass", AsyncNtupleWriter::kDouble);
+        writer->CreateColumn(gc2, "trkLen", AsyncNtupleWriter::kDouble);
+        writer->CreateColumn(gc2, "eDepSum", AsyncNtupleWriter::kDouble);
+        for(G4int i = 0;fEventAction->HasTrackSummary() && i < GasChamberTrackSummary::kNbOfValues;++i)
+            writer->CreateColumn(gc2, GasChamberTrackSummary::GetColumnName(static_cast<GasChamberTrackSummary::Value>(i)),
+                AsyncNtupleWriter::kDouble);
+    }
+    for(auto col : fEventAction->GetBookedStepColumns())
+    {
+        const auto &name = GasChamberStepStore::GetColumnName(col);
+        switch(GasChamberStepStore::GetColumnStorage(col).type)
+        {
+            case GasChamberStepStore::kFloat:
+                writer->CreateColumn(gc2, name, AsyncNtupleWriter::kFloatVector);
+                break;
+            case GasChamberStepStore::kFixedPoint:
+                writer->CreateColumn(gc2, name, AsyncNtupleWriter::kIntVector);
+                break;
+            default:
+                writer->CreateColumn(gc2, name, AsyncNtupleWriter::kDoubleVector);
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::CreateTuplesAncillary()
+{
+    // booked after the gas chamber tuples, so that their ids are not changed.
+    for(auto recorderNtuple : fEventAction->GetRecorderNtuples())
+        recorderNtuple->Book();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -96,4 +416,46 @@ void RunAction::DefineCommands()
     activateCmd.SetDefaultValue("true");
 
     fMessenger->DeclareProperty("setFileName", fFileName, "Set Name of output file.");
+
+    auto asyncCmd = fMessenger->DeclareProperty("async", fAsyncOutput,
+        "Write tree_gc1 and tree_gc2 to <fileName>_steps.root on a dedicated writer thread, not with shards.");
+    asyncCmd.SetParameterName("async", true);
+    asyncCmd.SetDefaultValue("true");
+    auto queueCmd = fMessenger->DeclareProperty("asyncQueueSize", fAsyncQueueSize,
+        "Number of finished events waiting for the writer thread, above which workers wait.");
+    queueCmd.SetParameterName("size", false);
+    queueCmd.SetRange("size >= 1");
+
+    auto shardsCmd = fMessenger->DeclareProperty("shards", fShardOutput,
+        "Write the ntuples of each worker to <fileName>_t<threadId>.root without merging them at the end of run,\n"
+        "and list them in <fileName>_shards.txt. To be set before the first run, and not with async.");
+    shardsCmd.SetParameterName("shards", true);
+    shardsCmd.SetDefaultValue("true");
+
+    auto compressionCmd = fMessenger->DeclareMethod("compression", &RunAction::SetCompression,
+        "Compression of output files, as zlib:<level>, none or default.");
+    compressionCmd.SetGuidance("The file of G4AnalysisManager can be compressed with zlib only, and other algorithms are rejected.");
+    compressionCmd.SetGuidance("Ntuples of the asynchronous output can be given lzma, lz4 or zstd by ntupleCompression.");
+    compressionCmd.SetParameterName("compression", false);
+
+    auto basketSizeCmd = fMessenger->DeclareMethod("basketSize", &RunAction::SetBasketSize,
+        "Basket size of branches in bytes, 0 for the default.");
+    basketSizeCmd.SetParameterName("bytes", false);
+    basketSizeCmd.SetRange("bytes >= 0");
+
+    auto autoFlushCmd = fMessenger->DeclareMethod("autoFlush", &RunAction::SetAutoFlush,
+        "Auto-flush of trees of the asynchronous output, in entries if positive and in bytes if negative, 0 for the default.");
+    autoFlushCmd.SetParameterName("autoFlush", false);
+
+    auto ntupleCompressionCmd = fMessenger->DeclareMethod("ntupleCompression", &RunAction::SetNtupleCompression,
+        "Compression of an ntuple written with ROOT, as <ntuple>,<algorithm>:<level> (e.g. tree_gc2,zstd:5).");
+    ntupleCompressionCmd.SetParameterName("ntupleCompression", false);
+
+    auto ntupleBasketSizeCmd = fMessenger->DeclareMethod("ntupleBasketSize", &RunAction::SetNtupleBasketSize,
+        "Basket size of an ntuple written with ROOT, as <ntuple>,<bytes>.");
+    ntupleBasketSizeCmd.SetParameterName("ntupleBasketSize", false);
+
+    auto ntupleAutoFlushCmd = fMessenger->DeclareMethod("ntupleAutoFlush", &RunAction::SetNtupleAutoFlush,
+        "Auto-flush of an ntuple written with ROOT, as <ntuple>,<entries or -bytes>.");
+    ntupleAutoFlushCmd.SetParameterName("ntupleAutoFlush", false);
 }
\ No newline at end of file
@@ -0,0 +1,274 @@
+/// \file AsyncNtupleWriter.cc
+/// \brief Implementation of the AsyncNtupleWriter class
+
+#include "analysis/AsyncNtupleWriter.hh"
+
+#include "G4Exception.hh"
+#include "G4ios.hh"
+
+#include "TROOT.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AsyncNtupleWriter *AsyncNtupleWriter::GetInstance()
+{
+    static AsyncNtupleWriter instance;
+    return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AsyncNtupleWriter::AsyncNtupleWriter()
+    : fNtuples(), fFileSettings(), fNtupleSettings(), fFile(nullptr), fThread(), fOpen(false), fStop(false), fQueue(), fFreeRecords(),
+    fWaitMutex(), fNotEmpty(), fNotFull(), fNbOfWaits(0), fNbOfRecords(0), fWriteTime(0.),
+    fTreeSizes()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AsyncNtupleWriter::~AsyncNtupleWriter()
+{
+    Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::ClearNtuples()
+{
+    fNtuples.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int AsyncNtupleWriter::CreateNtuple(const G4String &name, const G4String &title)
+{
+    fNtuples.push_back(std::make_unique<Ntuple>());
+    fNtuples.back()->name = name;
+    fNtuples.back()->title = title;
+    return fNtuples.size() - 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::CreateColumn(G4int ntupleId, const G4String &name, ColumnType type)
+{
+    fNtuples.at(ntupleId)->columns.emplace_back(name, type);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::SetOutputSettings(const OutputSettings &fileSettings,
+    const std::map<G4String, OutputSettings> &ntupleSettings)
+{
+    fFileSettings = fileSettings;
+    fNtupleSettings = ntupleSettings;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::Open(const G4String &fileName, G4int queueSize)
+{
+    if(IsOpen())
+        Close();
+    // the file is written by the writer thread while Geant4 threads run.
+    ROOT::EnableThreadSafety();
+    fFile = TFile::Open(fileName.c_str(), "RECREATE");
+    if(!fFile || fFile->IsZombie())
+    {
+        std::ostringstream message;
+        message << "Cannot open " << fileName << " for the asynchronous output.";
+        G4Exception("AsyncNtupleWriter::Open(const G4String &, G4int)", "AsyncWriter0000", FatalException, message);
+        return;
+    }
+    fFileSettings.Apply(fFile);
+    for(auto &ntuple : fNtuples)
+        CreateBranches(*ntuple);
+
+    fQueue = std::make_unique<BoundedQueue<EventRecord>>(std::max(queueSize, 1));
+    fFreeRecords = std::make_unique<BoundedQueue<EventRecord>>(2*fQueue->GetCapacity());
+    fNbOfWaits = 0;
+    fNbOfRecords = 0;
+    fWriteTime = 0.;
+    fStop.store(false, std::memory_order_release);
+    fThread = std::thread(&AsyncNtupleWriter::Run, this);
+    fOpen.store(true, std::memory_order_release);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::CreateBranches(Ntuple &ntuple)
+{
+    // buffers are sized before branches take their addresses.
+    G4int nbOfColumns[6] = {0, 0, 0, 0, 0, 0};
+    for(const auto &column : ntuple.columns)
+        ++nbOfColumns[column.second];
+    ntuple.ints.assign(nbOfColumns[kInt], 0);
+    ntuple.floats.assign(nbOfColumns[kFloat], 0.f);
+    ntuple.doubles.assign(nbOfColumns[kDouble], 0.);
+    ntuple.intVectors.assign(nbOfColumns[kIntVector], {});
+    ntuple.floatVectors.assign(nbOfColumns[kFloatVector], {});
+    ntuple.doubleVectors.assign(nbOfColumns[kDoubleVector], {});
+
+    fFile->cd();
+    ntuple.tree = new TTree(ntuple.name.c_str(), ntuple.title.c_str());
+    G4int index[6] = {0, 0, 0, 0, 0, 0};
+    for(const auto &column : ntuple.columns)
+    {
+        const char *name = column.first.c_str();
+        const G4int i = index[column.second]++;
+        switch(column.second)
+        {
+            case kInt:
+                ntuple.tree->Branch(name, &ntuple.ints[i], (column.first + "/I").c_str());
+                break;
+            case kFloat:
+                ntuple.tree->Branch(name, &ntuple.floats[i], (column.first + "/F").c_str());
+                break;
+            case kDouble:
+                ntuple.tree->Branch(name, &ntuple.doubles[i], (column.first + "/D").c_str());
+                break;
+            case kIntVector:
+                ntuple.tree->Branch(name, &ntuple.intVectors[i]);
+                break;
+            case kFloatVector:
+                ntuple.tree->Branch(name, &ntuple.floatVectors[i]);
+                break;
+            case kDoubleVector:
+                ntuple.tree->Branch(name, &ntuple.doubleVectors[i]);
+                break;
+        }
+    }
+    auto settings = fNtupleSettings.find(ntuple.name);
+    if(settings != fNtupleSettings.end())
+        fFileSettings.Override(settings->second).Apply(ntuple.tree);
+    else
+        fFileSettings.Apply(ntuple.tree);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::Close()
+{
+    if(!IsOpen())
+        return;
+    // called after all workers have finished the run, so no record is pushed any more.
+    fOpen.store(false, std::memory_order_release);
+    fStop.store(true, std::memory_order_release);
+    fNotEmpty.notify_one();
+    fThread.join();
+
+    EventRecord *record;
+    while(fFreeRecords->TryPop(record))
+        delete record;
+    G4cout << "AsyncNtupleWriter : " << fNbOfRecords << " events written to " << fFile->GetName()
+        << ", writer busy for " << fWriteTime << " s, "
+        << fNbOfWaits.load() << " waits of workers for a full queue." << G4endl;
+    OutputSettings::PrintCompression(fFile->GetName(), fTreeSizes, fWriteTime, "filling and writing the trees");
+    delete fFile;
+    fFile = nullptr;
+    for(auto &ntuple : fNtuples)
+        ntuple->tree = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EventRecord *AsyncNtupleWriter::AcquireRecord()
+{
+    EventRecord *record;
+    if(!fFreeRecords->TryPop(record))
+        record = new EventRecord;
+    record->Clear();
+    return record;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::Push(EventRecord *record)
+{
+    if(!fQueue->TryPush(record))
+    {
+        // The queue is full, so the worker waits for the writer instead of allocating more records.
+        // The timeout covers a wake-up missed between a failed push and the wait.
+        ++fNbOfWaits;
+        std::unique_lock<std::mutex> lock(fWaitMutex);
+        while(!fQueue->TryPush(record))
+            fNotFull.wait_for(lock, std::chrono::milliseconds(1));
+    }
+    fNotEmpty.notify_one();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::Run()
+{
+    EventRecord *record;
+    while(true)
+    {
+        if(fQueue->TryPop(record))
+        {
+            const auto start = std::chrono::steady_clock::now();
+            Write(record);
+            fWriteTime += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+            Release(record);
+            fNotFull.notify_all();
+            continue;
+        }
+        // the queue is empty and no record comes after the stop.
+        if(fStop.load(std::memory_order_acquire))
+            break;
+        std::unique_lock<std::mutex> lock(fWaitMutex);
+        fNotEmpty.wait_for(lock, std::chrono::milliseconds(1));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    fFile->Write();
+    fWriteTime += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+    // sizes are taken before the trees are deleted with the file, and printed by Close().
+    std::vector<TTree *> trees;
+    for(auto &ntuple : fNtuples)
+        trees.push_back(ntuple->tree);
+    fTreeSizes = OutputSettings::GetTreeSizes(trees);
+    fFile->Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::Write(EventRecord *record)
+{
+    for(G4int i = 0;i < record->nbOfRows;++i)
+    {
+        auto &row = record->rows[i];
+        auto &ntuple = *fNtuples[row.ntupleId];
+        std::copy_n(row.ints.begin(), std::min(row.ints.size(), ntuple.ints.size()), ntuple.ints.begin());
+        std::copy_n(row.floats.begin(), std::min(row.floats.size(), ntuple.floats.size()), ntuple.floats.begin());
+        std::copy_n(row.doubles.begin(), std::min(row.doubles.size(), ntuple.doubles.size()), ntuple.doubles.begin());
+        // vectors are lent to the branches for the fill, and the row gets its buffers back.
+        auto swapVectors = [](auto &rowVectors, auto &ntupleVectors)
+        {
+            const std::size_t n = std::min(rowVectors.size(), ntupleVectors.size());
+            for(std::size_t k = 0;k < n;++k)
+                rowVectors[k].swap(ntupleVectors[k]);
+        };
+        swapVectors(row.intVectors, ntuple.intVectors);
+        swapVectors(row.floatVectors, ntuple.floatVectors);
+        swapVectors(row.doubleVectors, ntuple.doubleVectors);
+        ntuple.tree->Fill();
+        swapVectors(row.intVectors, ntuple.intVectors);
+        swapVectors(row.floatVectors, ntuple.floatVectors);
+        swapVectors(row.doubleVectors, ntuple.doubleVectors);
+    }
+    ++fNbOfRecords;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncNtupleWriter::Release(EventRecord *record)
+{
+    if(!fFreeRecords->TryPush(record))
+        delete record;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
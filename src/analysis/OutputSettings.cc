@@ -0,0 +1,182 @@
+/// \file OutputSettings.cc
+/// \brief Implementation of the OutputSettings class
+
+#include "analysis/OutputSettings.hh"
+
+#include "G4Exception.hh"
+#include "G4ios.hh"
+
+#include "TBranch.h"
+#include "TKey.h"
+#include "TObjArray.h"
+
+#include <iomanip>
+#include <memory>
+#include <set>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+OutputSettings::OutputSettings()
+    : fAlgorithm(-1), fLevel(-1), fBasketSize(0), fAutoFlush(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool OutputSettings::SetCompression(const G4String &compression)
+{
+    if(compression == "default")
+    {
+        fAlgorithm = fLevel = -1;
+        return true;
+    }
+    if(compression == "none")
+    {
+        // level 0 is no compression for any algorithm.
+        fAlgorithm = kZLIB;
+        fLevel = 0;
+        return true;
+    }
+    const auto colon = compression.find(':');
+    const std::string name = compression.substr(0, colon);
+    G4int algorithm;
+    if(name == "zlib")
+        algorithm = kZLIB;
+    else if(name == "lzma")
+        algorithm = kLZMA;
+    else if(name == "lz4")
+        algorithm = kLZ4;
+    else if(name == "zstd")
+        algorithm = kZSTD;
+    else
+        return false;
+
+    G4int level = 1;
+    if(colon != std::string::npos)
+    {
+        std::istringstream ss(compression.substr(colon + 1));
+        if(!(ss >> level) || level < 0 || level > 9)
+            return false;
+    }
+    fAlgorithm = algorithm;
+    fLevel = level;
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String OutputSettings::GetCompressionName() const
+{
+    if(!HasCompression())
+        return "default";
+    if(fLevel == 0)
+        return "none";
+    static const char *names[] = {"", "zlib", "lzma", "", "lz4", "zstd"};
+    return G4String(names[fAlgorithm]) + ":" + std::to_string(fLevel);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+OutputSettings OutputSettings::Override(const OutputSettings &ntupleSettings) const
+{
+    OutputSettings settings = *this;
+    if(ntupleSettings.HasCompression())
+    {
+        settings.fAlgorithm = ntupleSettings.fAlgorithm;
+        settings.fLevel = ntupleSettings.fLevel;
+    }
+    if(ntupleSettings.fBasketSize > 0)
+        settings.fBasketSize = ntupleSettings.fBasketSize;
+    if(ntupleSettings.fAutoFlush != 0)
+        settings.fAutoFlush = ntupleSettings.fAutoFlush;
+    return settings;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OutputSettings::Apply(TFile *file) const
+{
+    if(HasCompression())
+        file->SetCompressionSettings(GetCompressionSettings());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OutputSettings::Apply(TTree *tree) const
+{
+    // Branches take the compression of the file when they are created, so that of a tree is set by branch.
+    if(HasCompression())
+    {
+        TIter next(tree->GetListOfBranches());
+        while(auto branch = static_cast<TBranch *>(next()))
+            branch->SetCompressionSettings(GetCompressionSettings());
+    }
+    if(fBasketSize > 0)
+        tree->SetBasketSize("*", fBasketSize);
+    if(fAutoFlush != 0)
+        tree->SetAutoFlush(fAutoFlush);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<OutputSettings::TreeSize> OutputSettings::GetTreeSizes(const std::vector<TTree *> &trees)
+{
+    std::vector<TreeSize> sizes;
+    for(auto tree : trees)
+        if(tree)
+            sizes.push_back({tree->GetName(), static_cast<G4double>(tree->GetTotBytes()),
+                static_cast<G4double>(tree->GetZipBytes())});
+    return sizes;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<OutputSettings::TreeSize> OutputSettings::GetTreeSizes(const G4String &fileName)
+{
+    std::vector<TreeSize> sizes;
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if(!file || file->IsZombie())
+    {
+        std::ostringstream message;
+        message << "Cannot open " << fileName << " for the compression report.";
+        G4Exception("OutputSettings::GetTreeSizes(const G4String &)", "OutputSettings0000", JustWarning, message);
+        return sizes;
+    }
+    // Keys of a name are listed from the highest cycle, which is the last written tree.
+    std::set<std::string> names;
+    TIter next(file->GetListOfKeys());
+    while(auto key = static_cast<TKey *>(next()))
+    {
+        if(std::string(key->GetClassName()) != "TTree" || !names.insert(key->GetName()).second)
+            continue;
+        std::unique_ptr<TTree> tree(key->ReadObject<TTree>());
+        sizes.push_back({key->GetName(), static_cast<G4double>(tree->GetTotBytes()),
+            static_cast<G4double>(tree->GetZipBytes())});
+    }
+    return sizes;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OutputSettings::PrintCompression(const G4String &fileName, const std::vector<TreeSize> &sizes,
+    G4double time, const G4String &timeLabel)
+{
+    G4double totBytes = 0., zipBytes = 0.;
+    const auto prec = G4cout.precision(3);
+    G4cout << "Compression of " << fileName << " :" << G4endl;
+    for(const auto &size : sizes)
+    {
+        G4cout << "  " << std::setw(14) << std::left << size.name << std::right
+            << std::setw(12) << size.totBytes/1048576. << " MB -> " << std::setw(12) << size.zipBytes/1048576.
+            << " MB, ratio " << (size.zipBytes > 0. ? size.totBytes/size.zipBytes : 0.) << G4endl;
+        totBytes += size.totBytes;
+        zipBytes += size.zipBytes;
+    }
+    G4cout << "  " << std::setw(14) << std::left << "total" << std::right
+        << std::setw(12) << totBytes/1048576. << " MB -> " << std::setw(12) << zipBytes/1048576.
+        << " MB, ratio " << (zipBytes > 0. ? totBytes/zipBytes : 0.) << G4endl;
+    G4cout << "  " << time << " s " << timeLabel << G4endl;
+    G4cout.precision(prec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,125 @@
+/// \file ShardManifest.cc
+/// \brief Implementation of the ShardManifest class
+
+#include "analysis/ShardManifest.hh"
+
+#include "G4Exception.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ShardManifest *ShardManifest::GetInstance()
+{
+    static ShardManifest instance;
+    return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ShardManifest::ShardManifest()
+    : fMutex(), fShards()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ShardManifest::~ShardManifest()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardManifest::Clear()
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fShards.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardManifest::AddShard(const Shard &shard)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fShards.push_back(shard);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardManifest::Write(const G4String &fileName)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    std::sort(fShards.begin(), fShards.end(),
+        [](const Shard &a, const Shard &b){return a.threadId < b.threadId;});
+    std::ofstream file(fileName);
+    if(!file)
+    {
+        std::ostringstream message;
+        message << "Cannot write the shard manifest " << fileName << ".";
+        G4Exception("ShardManifest::Write(const G4String &)", "ShardManifest0000", JustWarning, message);
+        return;
+    }
+    // Shard files are written in the directory of the manifest, and are listed relative to it, as Read() expects.
+    const auto slash = fileName.rfind('/');
+    const G4String directory = slash == std::string::npos ? "" : fileName.substr(0, slash + 1);
+    G4int nbOfEvents = 0;
+    file << "# file thread nbOfEvents firstEvtId lastEvtId" << std::endl;
+    for(const auto &shard : fShards)
+    {
+        std::string shardFileName = shard.fileName;
+        if(!directory.empty() && shardFileName.compare(0, directory.size(), directory) == 0)
+            shardFileName = shardFileName.substr(directory.size());
+        file << shardFileName << " " << shard.threadId << " " << shard.nbOfEvents << " "
+            << shard.firstEventId << " " << shard.lastEventId << std::endl;
+        nbOfEvents += shard.nbOfEvents;
+    }
+    G4cout << "ShardManifest : " << fShards.size() << " shards of " << nbOfEvents << " events listed in "
+        << fileName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<ShardManifest::Shard> ShardManifest::Read(const G4String &fileName)
+{
+    std::ifstream file(fileName);
+    if(!file)
+    {
+        std::ostringstream message;
+        message << "Cannot read the shard manifest " << fileName << ".";
+        G4Exception("ShardManifest::Read(const G4String &)", "ShardManifest0001", FatalException, message);
+        return {};
+    }
+    const auto slash = fileName.rfind('/');
+    const G4String directory = slash == std::string::npos ? "" : fileName.substr(0, slash + 1);
+
+    std::vector<Shard> shards;
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+        std::istringstream ss(line);
+        Shard shard;
+        std::string shardFileName;
+        if(!(ss >> shardFileName >> shard.threadId >> shard.nbOfEvents >> shard.firstEventId >> shard.lastEventId))
+        {
+            std::ostringstream message;
+            message << "Invalid line in the shard manifest " << fileName << " : " << line;
+            G4Exception("ShardManifest::Read(const G4String &)", "ShardManifest0002", FatalException, message);
+            continue;
+        }
+        shard.fileName = shardFileName[0] == '/' ? shardFileName : directory + shardFileName;
+        shards.push_back(shard);
+    }
+    return shards;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ShardManifest::IsManifest(const G4String &fileName)
+{
+    return fileName.size() > 4 && fileName.substr(fileName.size() - 4) == ".txt";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
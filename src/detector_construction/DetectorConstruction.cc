@@ -29,6 +29,10 @@
 
 #include "detector_construction/DetectorConstruction.hh"
 #include "gas_chamber/GasChamberSD.hh"
+#include "gas_chamber/GasChamberVoxelSD.hh"
+#include "recorder/RecorderSD.hh"
+#include "recorder/AncillaryRecorders.hh"
+#include "digitizer/GasTransportStore.hh"
 #include "config/ParamContainerTable.hh"
 
 #include "G4Exception.hh"
@@ -48,6 +52,7 @@
 
 #include "G4FieldManager.hh"
 #include "G4SDManager.hh"
+#include "G4LogicalVolumeStore.hh"
 #include "G4RunManager.hh"
 
 #include "G4Colour.hh"
@@ -348,13 +353,48 @@ void DetectorConstruction::SetVisAttributes()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+template<typename Traits>
+void DetectorConstruction::ConstructRecorderSD()
+{
+    const auto params = ParamContainerTable::GetContainer("ancillary");
+    if(!params->GetParamB(Traits::kName))
+        return;
+    const G4String volumeName = params->GetParamS(G4String(Traits::kName) + "Volume");
+    auto logicVolume = G4LogicalVolumeStore::GetInstance()->GetVolume(volumeName, false);
+    if(!logicVolume)
+    {
+        std::ostringstream message;
+        message << "Logical volume " << volumeName << " of " << Traits::kName << " not found, it is not recorded.";
+        G4Exception("DetectorConstruction::ConstructRecorderSD()", "Recorder0000", JustWarning, message);
+        return;
+    }
+    auto recorderSD = new RecorderSD<Traits>;
+    G4SDManager::GetSDMpointer()->AddNewDetector(recorderSD);
+    SetSensitiveDetector(logicVolume, recorderSD);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void DetectorConstruction::ConstructSDandField()
 {
     auto sdManager = G4SDManager::GetSDMpointer();
+    const auto params = ParamContainerTable::GetContainer("gas_chamber");
     G4String SDname;
-    auto gasChamberSD = new GasChamberSD(SDname = "/gasChamber");
-    sdManager->AddNewDetector(gasChamberSD);
-    fLogicChamber->SetSensitiveDetector(gasChamberSD);
+    // If both are enabled, SetSensitiveDetector() attaches them to the chamber with a G4MultiSensitiveDetector.
+    // Each can be switched off by /hits/inactivate, and its collection is then skipped by EventAction.
+    if(params->GetParamB("recordSteps"))
+    {
+        auto gasChamberSD = new GasChamberSD(SDname = "/gasChamber");
+        sdManager->AddNewDetector(gasChamberSD);
+        SetSensitiveDetector(fLogicChamber, gasChamberSD);
+    }
+    if(params->GetParamB("recordVoxels"))
+    {
+        auto gasChamberVoxelSD = new GasChamberVoxelSD(SDname = "/gasChamberVoxel");
+        sdManager->AddNewDetector(gasChamberVoxelSD);
+        SetSensitiveDetector(fLogicChamber, gasChamberVoxelSD);
+    }
+    ForEachAncillaryRecorder([this](auto traits) { ConstructRecorderSD<decltype(traits)>(); });
 
     fMagneticField = new MagneticField();
     fFieldManager = new G4FieldManager();
@@ -410,6 +450,14 @@ void DetectorConstruction::SetGas(const G4String &gas1, G4double frac1, const G4
     fGasMat = new G4Material("Gas", density, 2);
     fGasMat->AddMaterial(gasMat1, massFrac1);
     fGasMat->AddMaterial(gasMat2, massFrac2);
+    // mean energy per ion pair of the mixture weighted by mole fractions, used by the digitizer.
+    const G4double w1 = gasMat1->GetIonisation()->GetMeanEnergyPerIonPair();
+    const G4double w2 = gasMat2->GetIonisation()->GetMeanEnergyPerIonPair();
+    if(w1 > 0. && w2 > 0.)
+        fGasMat->GetIonisation()->SetMeanEnergyPerIonPair(1./(fFrac1*perCent/w1 + fFrac2*perCent/w2));
+    // W-value and transport properties of the new mixture for the digitizer
+    GasTransportStore::GetInstance()->SelectMixture(fGasName1, fFrac1, fGasName2, fFrac2, fPressure,
+        fGasMat->GetIonisation()->GetMeanEnergyPerIonPair());
     // if SetGas is called after Construct (by UI command)
     if(fLogicGas)
     {
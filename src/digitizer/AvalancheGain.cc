@@ -0,0 +1,58 @@
+/// \file AvalancheGain.cc
+/// \brief Implementation of the AvalancheGain class
+
+#include "digitizer/AvalancheGain.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AvalancheGain::AvalancheGain(const ParamContainer *params)
+    : fMeanGain(params->GetParamD("gain")), fTable(PolyaGainTable::Get(params->GetParamD("polyaTheta"))),
+    fUniforms()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AvalancheGain::~AvalancheGain()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AvalancheGain::Amplify(PadCharges &padCharges, std::vector<G4double> &padGains, CLHEP::HepRandomEngine &engine)
+{
+    padGains.resize(padCharges.Size());
+    for(G4int i = 0;i < padCharges.Size();++i)
+    {
+        G4double &charge = padCharges.charge[i];
+        G4int nbOfElectrons = static_cast<G4int>(charge);
+        // charge of the cluster mode is rounded up with the probability of its fraction.
+        const G4double fraction = charge - nbOfElectrons;
+        if(fraction > 0. && engine.flat() < fraction)
+            ++nbOfElectrons;
+        if(nbOfElectrons == 0)
+        {
+            padGains[i] = 0.;
+            charge = 0.;
+            continue;
+        }
+        fUniforms.resize(nbOfElectrons);
+        engine.flatArray(nbOfElectrons, fUniforms.data());
+        const G4double amplified = fMeanGain*fTable->SampleSum(fUniforms.data(), nbOfElectrons);
+        padGains[i] = amplified/charge;
+        charge = amplified;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AvalancheGain::ScaleWaveforms(const std::vector<G4double> &padGains, PadWaveforms &waveforms) const
+{
+    for(G4int i = 0;i < waveforms.Size();++i)
+    {
+        const G4float gain = padGains[i];
+        G4float *waveform = waveforms.GetWaveform(i);
+        for(G4int j = 0;j < waveforms.nbOfBuckets;++j)
+            waveform[j] *= gain;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
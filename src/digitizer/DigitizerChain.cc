@@ -0,0 +1,98 @@
+/// \file DigitizerChain.cc
+/// \brief Implementation of the DigitizerChain class
+
+#include "digitizer/DigitizerChain.hh"
+
+#include "G4Exception.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DigitizerChain::DigitizerChain(const ParamContainer *params, const ParamContainer *padPlaneParams)
+    : fMode(kElectron), fElectronDrift(nullptr), fPadPlane(nullptr), fPadResponse(nullptr), fAvalancheGain(nullptr),
+    fWaveformGenerator(nullptr),
+    fWaveformReadout(nullptr)
+{
+    const G4String mode = params->GetParamS("mode");
+    if(mode == "electron")
+        fMode = kElectron;
+    else if(mode == "cluster")
+        fMode = kCluster;
+    else
+    {
+        std::ostringstream message;
+        message << "Unknown digitizer mode " << mode << ".";
+        G4Exception("DigitizerChain::DigitizerChain()", "Digitizer0001", FatalException, message);
+    }
+    fElectronDrift = new ElectronDrift(params);
+    fPadPlane = new PadPlane(padPlaneParams);
+    if(fMode == kCluster)
+        fPadResponse = new PadResponse(fPadPlane, params->GetParamD("cloudRange"));
+    if(params->GetParamD("gain") > 0.)
+        fAvalancheGain = new AvalancheGain(params);
+    if(params->GetParamB("waveform"))
+    {
+        fWaveformGenerator = new WaveformGenerator(params);
+        fWaveformReadout = new WaveformReadout(params, fPadPlane->GetNbOfPads());
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DigitizerChain::~DigitizerChain()
+{
+    delete fElectronDrift;
+    delete fPadResponse;
+    delete fPadPlane;
+    delete fAvalancheGain;
+    delete fWaveformGenerator;
+    delete fWaveformReadout;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DigitizerChain::InitEvent(DigitizerEvent &event) const
+{
+    event.padCharges.Init(fPadPlane->GetNbOfPads());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DigitizerChain::Process(DigitizerEvent &event, CLHEP::HepRandomEngine &engine)
+{
+    if(fMode == kCluster)
+    {
+        fElectronDrift->DriftClusters(event.steps, event.clusters, engine);
+        // charge of each cluster on each pad is kept for the arrival times of waveforms.
+        fPadResponse->Collect(event.clusters, event.padCharges, fWaveformGenerator ? &event.clusterSignals : nullptr);
+    }
+    else
+    {
+        fElectronDrift->Drift(event.steps, event.electrons, engine);
+        CollectElectrons(event);
+    }
+    if(fAvalancheGain)
+        fAvalancheGain->Amplify(event.padCharges, event.padGains, engine);
+    if(fWaveformGenerator)
+    {
+        // waveforms are made from the collected electrons, and scaled by the gain of their pad.
+        fWaveformGenerator->Generate(event);
+        if(fAvalancheGain)
+            fAvalancheGain->ScaleWaveforms(event.padGains, event.waveforms);
+        fWaveformReadout->Read(event, engine);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DigitizerChain::CollectElectrons(DigitizerEvent &event) const
+{
+    auto &electrons = event.electrons;
+    fPadPlane->FindPads(electrons.x.data(), electrons.y.data(), electrons.Size(), electrons.pad.data());
+    for(auto pad : electrons.pad)
+        if(pad >= 0)
+            event.padCharges.Add(pad, 1.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
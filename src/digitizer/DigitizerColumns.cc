@@ -0,0 +1,96 @@
+/// \file DigitizerColumns.cc
+/// \brief Implementation of the DigitizerColumns class
+
+#include "digitizer/DigitizerColumns.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DigitizerColumns::DigitizerColumns(const ParamContainer *params)
+    : fWriteElectrons(params->GetParamB("writeElectrons")), fWritePadCharge(params->GetParamB("writePadCharge")),
+    fWriteWaveforms(params->GetParamB("waveform") && params->GetParamB("writeWaveforms")),
+    fWriteSparse(params->GetParamB("waveform") && params->GetParamB("writeSparse")),
+    fWriteBuckets(fWriteWaveforms && params->GetParamS("readoutMode") == "zero"),
+    fTrees(),
+    fEventId(-1), fNbOfElectrons(0), fNbOfPads(0), fNbOfReadoutPads(0), fNbOfSparsePads(0),
+    fElectronX(), fElectronY(), fElectronT(), fElectronPad(), fPads(), fPadCharge(),
+    fReadoutPads(), fReadoutNbOfSamples(), fReadoutBuckets(), fReadoutSamples(), fSparse()
+{
+    if(fWriteElectrons)
+    {
+        fTrees.push_back({"tree_drift", "drifted electrons saved by event", {
+            IntColumn("evtId", &fEventId), IntColumn("Nele", &fNbOfElectrons),
+            FloatColumn("x", &fElectronX), FloatColumn("y", &fElectronY), FloatColumn("t", &fElectronT),
+            IntColumn("pad", &fElectronPad)}});
+    }
+    if(fWritePadCharge)
+    {
+        fTrees.push_back({"tree_pad", "pad charge saved by event", {
+            IntColumn("evtId", &fEventId), IntColumn("Npad", &fNbOfPads),
+            IntColumn("pad", &fPads), FloatColumn("q", &fPadCharge)}});
+    }
+    if(fWriteWaveforms)
+    {
+        Tree tree{"tree_wave", "readout samples saved by event", {
+            IntColumn("evtId", &fEventId), IntColumn("Npad", &fNbOfReadoutPads),
+            IntColumn("pad", &fReadoutPads), IntColumn("nSample", &fReadoutNbOfSamples)}};
+        if(fWriteBuckets)
+            tree.columns.push_back(IntColumn("bucket", &fReadoutBuckets));
+        tree.columns.push_back(FloatColumn("adc", &fReadoutSamples));
+        fTrees.push_back(tree);
+    }
+    if(fWriteSparse)
+    {
+        fTrees.push_back({"tree_sparse", "readout samples in the sparse layout saved by event", {
+            IntColumn("evtId", &fEventId), IntColumn("Npad", &fNbOfSparsePads),
+            IntColumn("pad", &fSparse.pads), IntColumn("nRange", &fSparse.nbOfRanges),
+            IntColumn("start", &fSparse.rangeStart), IntColumn("length", &fSparse.rangeLength),
+            FloatColumn("adc", &fSparse.samples)}});
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DigitizerColumns::~DigitizerColumns()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DigitizerColumns::Fill(const DigitizerEvent &event)
+{
+    fEventId = event.eventId;
+    if(fWriteElectrons)
+    {
+        const auto &electrons = event.electrons;
+        fNbOfElectrons = electrons.Size();
+        fElectronX.assign(electrons.x.begin(), electrons.x.end());
+        fElectronY.assign(electrons.y.begin(), electrons.y.end());
+        fElectronT.assign(electrons.t.begin(), electrons.t.end());
+        fElectronPad.assign(electrons.pad.begin(), electrons.pad.end());
+    }
+    if(fWritePadCharge)
+    {
+        const auto &padCharges = event.padCharges;
+        fNbOfPads = padCharges.Size();
+        fPads.assign(padCharges.pads.begin(), padCharges.pads.end());
+        fPadCharge.assign(padCharges.charge.begin(), padCharges.charge.end());
+    }
+    if(fWriteWaveforms)
+    {
+        const auto &readout = event.readout;
+        fNbOfReadoutPads = readout.Size();
+        fReadoutPads.assign(readout.pads.begin(), readout.pads.end());
+        fReadoutNbOfSamples.resize(readout.Size());
+        for(G4int i = 0;i < readout.Size();++i)
+            fReadoutNbOfSamples[i] = readout.GetNbOfSamples(i);
+        if(fWriteBuckets)
+            fReadoutBuckets.assign(readout.buckets.begin(), readout.buckets.end());
+        fReadoutSamples.assign(readout.samples.begin(), readout.samples.end());
+    }
+    if(fWriteSparse)
+    {
+        fSparse.Encode(event.readout);
+        fNbOfSparsePads = fSparse.Size();
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,60 @@
+/// \file DigitizerNtuple.cc
+/// \brief Implementation of the DigitizerNtuple class
+
+#include "digitizer/DigitizerNtuple.hh"
+#include "AnalysisManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DigitizerNtuple::DigitizerNtuple(const ParamContainer *params)
+    : fColumns(params), fNtupleIds()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DigitizerNtuple::~DigitizerNtuple()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DigitizerNtuple::Book()
+{
+    using Column = DigitizerColumns::Column;
+    auto analysisManager = G4AnalysisManager::Instance();
+    fNtupleIds.clear();
+    for(const auto &tree : fColumns.GetTrees())
+    {
+        const G4int ntupleId = analysisManager->CreateNtuple(tree.name, tree.title);
+        for(const auto &column : tree.columns)
+        {
+            if(column.type == Column::kInt)
+                analysisManager->CreateNtupleIColumn(ntupleId, column.name);
+            else if(column.type == Column::kIntVector)
+                analysisManager->CreateNtupleIColumn(ntupleId, column.name, *column.ints);
+            else
+                analysisManager->CreateNtupleFColumn(ntupleId, column.name, *column.floats);
+        }
+        analysisManager->FinishNtuple(ntupleId);
+        fNtupleIds.push_back(ntupleId);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DigitizerNtuple::Fill(const DigitizerEvent &event)
+{
+    // vector columns are bound to the buffers, and only scalar columns are filled by their index.
+    auto analysisManager = G4AnalysisManager::Instance();
+    fColumns.Fill(event);
+    const auto &trees = fColumns.GetTrees();
+    for(std::size_t i = 0;i < trees.size();++i)
+    {
+        const auto &columns = trees[i].columns;
+        for(std::size_t j = 0;j < columns.size();++j)
+            if(columns[j].type == DigitizerColumns::Column::kInt)
+                analysisManager->FillNtupleIColumn(fNtupleIds[i], j, *columns[j].value);
+        analysisManager->AddNtupleRow(fNtupleIds[i]);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,115 @@
+/// \file DistortionMap.cc
+/// \brief Implementation of the DistortionMap class
+
+#include "digitizer/DistortionMap.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4Exception.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::shared_ptr<const DistortionMap> DistortionMap::Load(const G4String &fileName)
+{
+    static std::mutex mutex;
+    static std::map<G4String, std::shared_ptr<const DistortionMap>> maps;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = maps.find(fileName);
+    if(found != maps.end())
+        return found->second;
+
+    auto map = std::make_shared<DistortionMap>();
+    if(!map->ReadText(fileName))
+    {
+        std::ostringstream message;
+        message << "Cannot read distortion map " << fileName << ", electrons are drifted without distortion.";
+        G4Exception("DistortionMap::Load()", "Digitizer0006", JustWarning, message);
+        map = nullptr;
+    }
+    maps.emplace(fileName, map);
+    return map;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DistortionMap::DistortionMap()
+    : fNbOfNodes{0, 0, 0}, fOrigin{0., 0., 0.}, fStep{1., 1., 1.}, fDisplacements()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DistortionMap::~DistortionMap()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool DistortionMap::ReadText(const G4String &fileName)
+{
+    std::ifstream fileIn(fileName.data());
+    if(!fileIn.is_open())
+        return false;
+    for(G4int i = 0;i < 3;++i)
+        fileIn >> fNbOfNodes[i];
+    for(G4int i = 0;i < 3;++i)
+        fileIn >> fOrigin[i];
+    for(G4int i = 0;i < 3;++i)
+        fileIn >> fStep[i];
+    if(!fileIn || std::min({fNbOfNodes[0], fNbOfNodes[1], fNbOfNodes[2]}) < 1
+        || std::min({fStep[0], fStep[1], fStep[2]}) <= 0.)
+        return false;
+    for(G4int i = 0;i < 3;++i)
+    {
+        fOrigin[i] *= mm;
+        fStep[i] *= mm;
+    }
+
+    const size_t nbOfValues = 3*static_cast<size_t>(fNbOfNodes[0])*fNbOfNodes[1]*fNbOfNodes[2];
+    fDisplacements.resize(nbOfValues);
+    for(size_t i = 0;i < nbOfValues;++i)
+    {
+        G4double value;
+        fileIn >> value;
+        fDisplacements[i] = value*mm;
+    }
+    return static_cast<G4bool>(fileIn);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DistortionMap::Interpolate(G4double x, G4double y, G4double z, G4double *d) const
+{
+    // lower node and weight of the upper node along each axis, clamped to the grid
+    const G4double pos[3] = {x, y, z};
+    G4int lower[3], stride[3];
+    G4double weight[3];
+    for(G4int i = 0;i < 3;++i)
+    {
+        const G4double u = std::min(std::max((pos[i] - fOrigin[i])/fStep[i], 0.), fNbOfNodes[i] - 1.);
+        lower[i] = std::min(static_cast<G4int>(u), std::max(fNbOfNodes[i] - 2, 0));
+        weight[i] = u - lower[i];
+        // no upper node along an axis of one node
+        stride[i] = fNbOfNodes[i] > 1 ? 1 : 0;
+    }
+    const G4int nx = fNbOfNodes[0], ny = fNbOfNodes[1];
+    const G4int dx = 3*stride[0], dy = 3*nx*stride[1], dz = 3*nx*ny*stride[2];
+    const G4float *node = fDisplacements.data() + 3*((lower[2]*ny + lower[1])*nx + lower[0]);
+    for(G4int k = 0;k < 3;++k)
+    {
+        const G4float *v = node + k;
+        const G4double c00 = v[0] + weight[0]*(v[dx] - v[0]);
+        const G4double c10 = v[dy] + weight[0]*(v[dy + dx] - v[dy]);
+        const G4double c01 = v[dz] + weight[0]*(v[dz + dx] - v[dz]);
+        const G4double c11 = v[dz + dy] + weight[0]*(v[dz + dy + dx] - v[dz + dy]);
+        const G4double c0 = c00 + weight[1]*(c10 - c00);
+        const G4double c1 = c01 + weight[1]*(c11 - c01);
+        d[k] = c0 + weight[2]*(c1 - c0);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,156 @@
+/// \file ElectronDrift.cc
+/// \brief Implementation of the ElectronDrift class
+
+#include "digitizer/ElectronDrift.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ElectronDrift::ElectronDrift(const ParamContainer *params)
+    : fMeanEnergyPerIonPair(params->GetParamD("wValue")*eV),
+    fFanoFactor(params->GetParamD("fanoFactor")),
+    fDriftVelocity(params->GetParamD("driftVelocity")*cm/microsecond),
+    fDiffusionL(params->GetParamD("diffusionL")*std::sqrt(cm)),
+    fDiffusionT(params->GetParamD("diffusionT")*std::sqrt(cm)),
+    fPadPlaneZ(params->GetParamD("padPlaneZ")*mm), fDistortionMap(),
+    fNbOfElectrons(), fGaussians()
+{
+    const G4String distortionMap = params->GetParamS("distortionMap");
+    if(distortionMap != "none")
+        fDistortionMap = DistortionMap::Load(distortionMap);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ElectronDrift::~ElectronDrift()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ElectronDrift::Drift(const DigitizerSteps &steps, DriftElectrons &electrons, CLHEP::HepRandomEngine &engine)
+{
+    electrons.Clear();
+    if(!CheckMeanEnergyPerIonPair())
+        return;
+
+    // number of electrons of each step
+    const G4int nbOfSteps = steps.Size();
+    fNbOfElectrons.resize(nbOfSteps);
+    for(G4int i = 0;i < nbOfSteps;++i)
+        fNbOfElectrons[i] = SampleNbOfElectrons(steps.eDep[i]/fMeanEnergyPerIonPair, engine);
+    const G4int nbOfElectrons = std::accumulate(fNbOfElectrons.begin(), fNbOfElectrons.end(), 0);
+    electrons.Resize(nbOfElectrons);
+
+    // all gaussian numbers of the event in one batch, three per electron
+    fGaussians.resize(3*nbOfElectrons);
+    if(nbOfElectrons > 0)
+        CLHEP::RandGaussQ::shootArray(&engine, 3*nbOfElectrons, fGaussians.data());
+
+    G4double *__restrict x = electrons.x.data();
+    G4double *__restrict y = electrons.y.data();
+    G4double *__restrict t = electrons.t.data();
+    const G4double *__restrict gx = fGaussians.data();
+    const G4double *__restrict gy = gx + nbOfElectrons;
+    const G4double *__restrict gt = gy + nbOfElectrons;
+    G4int first = 0;
+    for(G4int i = 0;i < nbOfSteps;++i)
+    {
+        // constants of the step, so that the loop over its electrons is vectorized.
+        const G4double driftLength = std::abs(fPadPlaneZ - steps.z[i]);
+        const G4double sqrtLength = std::sqrt(driftLength);
+        const G4double sigmaT = fDiffusionT*sqrtLength;
+        const G4double sigmaTime = fDiffusionL*sqrtLength/fDriftVelocity;
+        G4double x0, y0, t0;
+        GetArrival(steps, i, x0, y0, t0);
+        const G4int last = first + fNbOfElectrons[i];
+        for(G4int j = first;j < last;++j)
+        {
+            x[j] = x0 + sigmaT*gx[j];
+            y[j] = y0 + sigmaT*gy[j];
+            t[j] = t0 + sigmaTime*gt[j];
+        }
+        first = last;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ElectronDrift::DriftClusters(const DigitizerSteps &steps, ChargeClusters &clusters, CLHEP::HepRandomEngine &engine)
+{
+    clusters.Clear();
+    if(!CheckMeanEnergyPerIonPair())
+        return;
+
+    const G4int nbOfSteps = steps.Size();
+    clusters.Resize(nbOfSteps);
+    for(G4int i = 0;i < nbOfSteps;++i)
+    {
+        const G4double driftLength = std::abs(fPadPlaneZ - steps.z[i]);
+        const G4double sqrtLength = std::sqrt(driftLength);
+        GetArrival(steps, i, clusters.x[i], clusters.y[i], clusters.t[i]);
+        clusters.sigma[i] = fDiffusionT*sqrtLength;
+        clusters.sigmaTime[i] = fDiffusionL*sqrtLength/fDriftVelocity;
+        clusters.charge[i] = SampleNbOfElectrons(steps.eDep[i]/fMeanEnergyPerIonPair, engine);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ElectronDrift::GetArrival(const DigitizerSteps &steps, G4int i, G4double &x, G4double &y, G4double &t) const
+{
+    G4double driftLength = std::abs(fPadPlaneZ - steps.z[i]);
+    x = steps.x[i];
+    y = steps.y[i];
+    if(fDistortionMap)
+    {
+        G4double displacement[3];
+        fDistortionMap->Interpolate(steps.x[i], steps.y[i], steps.z[i], displacement);
+        x += displacement[0];
+        y += displacement[1];
+        driftLength += displacement[2];
+    }
+    t = steps.t[i] + driftLength/fDriftVelocity;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ElectronDrift::CheckMeanEnergyPerIonPair() const
+{
+    // fatal at the first event, rather than an event without electrons for every event of the run.
+    if(fMeanEnergyPerIonPair > 0.)
+        return true;
+    std::ostringstream message;
+    message << "Mean energy per ion pair is " << fMeanEnergyPerIonPair/eV << " eV, no electron can be produced. "
+        << "Set wValue of the digitizer parameters, or the mean energy per ion pair of the gas material.";
+    G4Exception("ElectronDrift::CheckMeanEnergyPerIonPair()", "Digitizer0000", FatalException, message);
+    return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int ElectronDrift::SampleNbOfElectrons(G4double meanNbOfElectrons, CLHEP::HepRandomEngine &engine) const
+{
+    // Binomial for small numbers and gaussian otherwise, both of variance F*mean,
+    // so that the fluctuation does not jump at the switch.
+    // The binomial of ceil(mean/(1 - F)) trials with the mean kept exact has a variance of F*mean
+    // up to the rounding of the trials. A Fano factor of one or more is taken as Poisson.
+    if(meanNbOfElectrons <= 0.)
+        return 0;
+    if(meanNbOfElectrons < 20.)
+    {
+        if(fFanoFactor >= 1.)
+            return CLHEP::RandPoisson::shoot(&engine, meanNbOfElectrons);
+        const long nbOfTrials = std::ceil(meanNbOfElectrons/(1. - std::max(fFanoFactor, 0.)));
+        return CLHEP::RandBinomial::shoot(&engine, nbOfTrials, meanNbOfElectrons/nbOfTrials);
+    }
+    const G4double n = CLHEP::RandGaussQ::shoot(&engine, meanNbOfElectrons, std::sqrt(fFanoFactor*meanNbOfElectrons));
+    return n > 0. ? static_cast<G4int>(n + 0.5) : 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
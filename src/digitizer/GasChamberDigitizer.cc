@@ -0,0 +1,108 @@
+/// \file GasChamberDigitizer.cc
+/// \brief Implementation of the GasChamberDigitizer class
+
+#include "digitizer/GasChamberDigitizer.hh"
+#include "digitizer/GasTransportStore.hh"
+#include "gas_chamber/GasChamberHit.hh"
+#include "config/ParamContainerTable.hh"
+
+#include "G4DigiManager.hh"
+#include "G4RunManager.hh"
+#include "G4Event.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberDigitizer::GasChamberDigitizer(G4String name)
+    : G4VDigitizerModule(name),
+    fChain(nullptr), fEvent(), fGasChamberHcId(-1), fUseGasW(true),
+    fUseTransportTable(false), fDriftField(0.), fParamTransport(), fGasGeneration(-1)
+{
+    const auto params = ParamContainerTable::GetContainer("digitizer");
+    fUseTransportTable = params->GetParamB("useTransportTable");
+    fDriftField = params->GetParamD("driftField")*volt/cm;
+    fChain = new DigitizerChain(params, ParamContainerTable::GetContainer("pad_plane"));
+    fChain->InitEvent(fEvent);
+    // W-value of the parameter file overrides that of the gas material if positive.
+    fUseGasW = fChain->GetElectronDrift()->GetMeanEnergyPerIonPair() <= 0.;
+    const auto drift = fChain->GetElectronDrift();
+    const auto gain = fChain->GetAvalancheGain();
+    fParamTransport = {drift->GetDriftVelocity(), drift->GetDiffusionL(), drift->GetDiffusionT(),
+        gain ? gain->GetMeanGain() : 0.};
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberDigitizer::~GasChamberDigitizer()
+{
+    delete fChain;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberDigitizer::Digitize()
+{
+    fEvent.Clear();
+    fEvent.eventId = G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID();
+    FillSteps();
+    UpdateGas();
+    fChain->Process(fEvent, *G4Random::getTheEngine());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberDigitizer::FillSteps()
+{
+    auto digiManager = G4DigiManager::GetDMpointer();
+    if(fGasChamberHcId < 0)
+        fGasChamberHcId = digiManager->GetHitsCollectionID("gasChamber/GasChamberHColl");
+    if(fGasChamberHcId < 0)
+        return;
+    auto hitCol = static_cast<const GasChamberHitsCollection *>(digiManager->GetHitsCollection(fGasChamberHcId));
+    if(!hitCol)
+        return;
+
+    using Store = GasChamberStepStore;
+    for(size_t i = 0;i < hitCol->GetSize();++i)
+    {
+        const auto hit = (*hitCol)[i];
+        const G4int nbOfSteps = hit->GetNbOfStepValues(Store::kEdep);
+        if(nbOfSteps == 0 || hit->GetNbOfStepValues(Store::kPosX) != nbOfSteps
+            || hit->GetNbOfStepValues(Store::kPosY) != nbOfSteps || hit->GetNbOfStepValues(Store::kPosZ) != nbOfSteps)
+            continue;
+        const G4bool hasTime = hit->GetNbOfStepValues(Store::kTime) == nbOfSteps;
+        for(G4int j = 0;j < nbOfSteps;++j)
+        {
+            fEvent.steps.Append(hit->GetStepValue(Store::kPosX, j), hit->GetStepValue(Store::kPosY, j),
+                hit->GetStepValue(Store::kPosZ, j), hit->GetStepValue(Store::kEdep, j),
+                hasTime ? hit->GetStepValue(Store::kTime, j) : 0.);
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberDigitizer::UpdateGas()
+{
+    // the gas is looked up only when the gas mixture has changed.
+    auto store = GasTransportStore::GetInstance();
+    const G4int generation = store->GetGeneration();
+    if(generation == fGasGeneration)
+        return;
+    fGasGeneration = generation;
+    auto drift = fChain->GetElectronDrift();
+    if(fUseGasW)
+        drift->SetMeanEnergyPerIonPair(store->GetCurrentMeanEnergyPerIonPair());
+    if(!fUseTransportTable)
+        return;
+    // a mixture without a table has the transport properties of the parameters, as GasTransportStore tells.
+    const auto table = store->GetCurrentTable();
+    const GasTransport transport = table ? table->Interpolate(fDriftField) : fParamTransport;
+    drift->SetDriftVelocity(transport.driftVelocity);
+    drift->SetDiffusion(transport.diffusionL, transport.diffusionT);
+    if(fChain->GetAvalancheGain())
+        fChain->GetAvalancheGain()->SetMeanGain(transport.gain > 0. ? transport.gain : fParamTransport.gain);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,134 @@
+/// \file GasTransportStore.cc
+/// \brief Implementation of the GasTransportStore class
+
+#include "digitizer/GasTransportStore.hh"
+#include "config/ParamContainerTable.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4Exception.hh"
+#include "G4ios.hh"
+
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasTransportStore *GasTransportStore::GetInstance()
+{
+    static GasTransportStore instance;
+    return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasTransportStore::GasTransportStore()
+    : fEnabled(false), fTransportDir(), fCacheDir(),
+    fMutex(), fTables(), fCurrentTable(), fCurrentMeanEnergyPerIonPair(0.), fGeneration(0)
+{
+    const auto params = ParamContainerTable::GetContainer("digitizer");
+    fEnabled = params->GetParamB("enable") && params->GetParamB("useTransportTable");
+    fTransportDir = params->GetParamS("transportDir");
+    fCacheDir = params->GetParamS("transportCacheDir");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasTransportStore::~GasTransportStore()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String GasTransportStore::MakeKey(const G4String &gas1, G4double frac1, const G4String &gas2, G4double frac2, G4double pressure)
+{
+    char key[256];
+    snprintf(key, sizeof(key), "%s_%g_%s_%g_%.2fatm", gas1.data(), frac1, gas2.data(), frac2, pressure/atmosphere);
+    return key;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasTransportStore::SelectMixture(const G4String &gas1, G4double frac1, const G4String &gas2, G4double frac2, G4double pressure,
+    G4double meanEnergyPerIonPair)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fCurrentMeanEnergyPerIonPair = meanEnergyPerIonPair;
+    if(fEnabled)
+    {
+        const G4String key = MakeKey(gas1, frac1, gas2, frac2, pressure);
+        auto found = fTables.find(key);
+        if(found == fTables.end())
+            found = fTables.emplace(key, Load(key)).first;
+        fCurrentTable = found->second;
+    }
+    fGeneration.fetch_add(1, std::memory_order_release);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::shared_ptr<const GasTransportTable> GasTransportStore::GetCurrentTable() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fCurrentTable;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double GasTransportStore::GetCurrentMeanEnergyPerIonPair() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fCurrentMeanEnergyPerIonPair;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::shared_ptr<const GasTransportTable> GasTransportStore::Load(const G4String &key) const
+{
+    namespace fs = std::filesystem;
+    const fs::path textFile = fs::path(fTransportDir.data())/(key + ".txt");
+    const fs::path cacheFile = fs::path(fCacheDir.data())/(key + ".bin");
+    std::error_code error;
+    if(!fs::exists(textFile, error))
+    {
+        std::ostringstream message;
+        message << "No transport table " << textFile.string() << ", parameters of the digitizer are used.";
+        G4Exception("GasTransportStore::Load()", "GasTransport0000", JustWarning, message);
+        return nullptr;
+    }
+    // the cache is valid while the text file is not modified.
+    const G4long stamp = fs::last_write_time(textFile, error).time_since_epoch().count() ^ fs::file_size(textFile, error);
+
+    auto table = std::make_shared<GasTransportTable>();
+    if(table->ReadBinary(cacheFile.string(), stamp))
+    {
+        G4cout << "Transport table " << key << " read from " << cacheFile.string() << G4endl;
+        return table;
+    }
+    if(!table->ReadText(textFile.string()))
+    {
+        std::ostringstream message;
+        message << "Cannot read transport table " << textFile.string() << ", parameters of the digitizer are used.";
+        G4Exception("GasTransportStore::Load()", "GasTransport0001", JustWarning, message);
+        return nullptr;
+    }
+    G4cout << "Transport table " << key << " read from " << textFile.string() << G4endl;
+
+    // written to a temporary file and renamed, so that other processes never read a partial cache.
+    fs::create_directories(fCacheDir.data(), error);
+    const fs::path tmpFile = cacheFile.string() + ".tmp";
+    G4bool written = table->WriteBinary(tmpFile.string(), stamp);
+    if(written)
+    {
+        fs::rename(tmpFile, cacheFile, error);
+        written = !error;
+    }
+    if(!written)
+    {
+        std::ostringstream message;
+        message << "Cannot write the cache of transport table " << cacheFile.string() << ".";
+        G4Exception("GasTransportStore::Load()", "GasTransport0002", JustWarning, message);
+    }
+    return table;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,146 @@
+/// \file GasTransportTable.cc
+/// \brief Implementation of the GasTransportTable class
+
+#include "digitizer/GasTransportTable.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    constexpr char kMagic[8] = {'A', 'T', 'T', 'P', 'C', 'G', 'T', '1'};
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasTransportTable::GasTransportTable()
+    : fField(), fDriftVelocity(), fDiffusionL(), fDiffusionT(), fGain()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasTransportTable::~GasTransportTable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool GasTransportTable::ReadText(const G4String &fileName)
+{
+    std::ifstream fileIn(fileName.data());
+    if(!fileIn.is_open())
+        return false;
+
+    struct Point
+    {
+        G4double field, driftVelocity, diffusionL, diffusionT, gain;
+    };
+    std::vector<Point> points;
+    std::string line;
+    while(std::getline(fileIn, line))
+    {
+        line = line.substr(0, line.find('#'));
+        std::stringstream ss(line);
+        Point point;
+        if(!(ss >> point.field >> point.driftVelocity >> point.diffusionL >> point.diffusionT >> point.gain))
+            continue;
+        point.field *= volt/cm;
+        point.driftVelocity *= cm/microsecond;
+        point.diffusionL *= std::sqrt(cm);
+        point.diffusionT *= std::sqrt(cm);
+        points.push_back(point);
+    }
+    if(points.empty())
+        return false;
+    std::sort(points.begin(), points.end(), [](const Point &a, const Point &b) { return a.field < b.field; });
+
+    const size_t n = points.size();
+    fField.resize(n);
+    fDriftVelocity.resize(n);
+    fDiffusionL.resize(n);
+    fDiffusionT.resize(n);
+    fGain.resize(n);
+    for(size_t i = 0;i < n;++i)
+    {
+        fField[i] = points[i].field;
+        fDriftVelocity[i] = points[i].driftVelocity;
+        fDiffusionL[i] = points[i].diffusionL;
+        fDiffusionT[i] = points[i].diffusionT;
+        fGain[i] = points[i].gain;
+    }
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool GasTransportTable::ReadBinary(const G4String &fileName, G4long sourceStamp)
+{
+    std::ifstream fileIn(fileName.data(), std::ios::binary);
+    if(!fileIn.is_open())
+        return false;
+    char magic[8];
+    std::int64_t stamp = 0, n = 0;
+    fileIn.read(magic, sizeof(magic));
+    fileIn.read(reinterpret_cast<char *>(&stamp), sizeof(stamp));
+    fileIn.read(reinterpret_cast<char *>(&n), sizeof(n));
+    if(!fileIn || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || stamp != sourceStamp || n <= 0)
+        return false;
+    for(auto column : {&fField, &fDriftVelocity, &fDiffusionL, &fDiffusionT, &fGain})
+    {
+        column->resize(n);
+        fileIn.read(reinterpret_cast<char *>(column->data()), n*sizeof(G4double));
+    }
+    if(!fileIn)
+    {
+        for(auto column : {&fField, &fDriftVelocity, &fDiffusionL, &fDiffusionT, &fGain})
+            column->clear();
+        return false;
+    }
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool GasTransportTable::WriteBinary(const G4String &fileName, G4long sourceStamp) const
+{
+    std::ofstream fileOut(fileName.data(), std::ios::binary | std::ios::trunc);
+    if(!fileOut.is_open())
+        return false;
+    const std::int64_t stamp = sourceStamp, n = fField.size();
+    fileOut.write(kMagic, sizeof(kMagic));
+    fileOut.write(reinterpret_cast<const char *>(&stamp), sizeof(stamp));
+    fileOut.write(reinterpret_cast<const char *>(&n), sizeof(n));
+    for(auto column : {&fField, &fDriftVelocity, &fDiffusionL, &fDiffusionT, &fGain})
+        fileOut.write(reinterpret_cast<const char *>(column->data()), n*sizeof(G4double));
+    return static_cast<G4bool>(fileOut);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasTransport GasTransportTable::Interpolate(G4double field) const
+{
+    const G4int n = fField.size();
+    if(n == 0)
+        return {0., 0., 0., 0.};
+    // index of the first point above the field, clamped to the table
+    const G4int upper = std::upper_bound(fField.begin(), fField.end(), field) - fField.begin();
+    if(upper == 0 || upper == n)
+    {
+        const G4int i = upper == 0 ? 0 : n - 1;
+        return {fDriftVelocity[i], fDiffusionL[i], fDiffusionT[i], fGain[i]};
+    }
+    const G4int i = upper - 1;
+    const G4double f = (field - fField[i])/(fField[upper] - fField[i]);
+    auto lerp = [i, upper, f](const std::vector<G4double> &column)
+    {
+        return column[i] + f*(column[upper] - column[i]);
+    };
+    return {lerp(fDriftVelocity), lerp(fDiffusionL), lerp(fDiffusionT), lerp(fGain)};
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
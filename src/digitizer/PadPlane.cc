@@ -0,0 +1,252 @@
+/// \file PadPlane.cc
+/// \brief Implementation of the PadPlane class
+
+#include "digitizer/PadPlane.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4Exception.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PadPlane::PadPlane(const ParamContainer *params)
+    : fCenterX0(params->GetParamD("centerX")*mm), fCenterY0(params->GetParamD("centerY")*mm),
+    fVertexX(), fVertexY(), fNbOfVertices(), fCenterX(), fCenterY(),
+    fGridX0(0), fGridY0(0), fCellSize(0), fNbOfCellsX(0), fNbOfCellsY(0), fCellStart(), fCellPads()
+{
+    const G4String layout = params->GetParamS("layout");
+    const G4double padSize = params->GetParamD("padSize")*mm;
+    if(layout == "triangular")
+        GenerateTriangular(params->GetParamD("radius")*mm, padSize);
+    else if(layout == "hexagonal")
+        GenerateHexagonal(params->GetParamD("radius")*mm, padSize);
+    else if(layout == "custom")
+    {
+        // triangles given by x1 y1 x2 y2 x3 y3 relative to the center
+        const auto vertices = params->GetParamVecD("vertices");
+        for(size_t i = 0;i + 6 <= vertices.size();i += 6)
+        {
+            const G4double x[3] = {vertices[i]*mm, vertices[i + 2]*mm, vertices[i + 4]*mm};
+            const G4double y[3] = {vertices[i + 1]*mm, vertices[i + 3]*mm, vertices[i + 5]*mm};
+            AddPad(x, y, 3);
+        }
+    }
+    else
+    {
+        std::ostringstream message;
+        message << "Unknown pad plane layout " << layout << ".";
+        G4Exception("PadPlane::PadPlane(const ParamContainer *)", "PadPlane0000", FatalException, message);
+    }
+    if(GetNbOfPads() == 0)
+        G4Exception("PadPlane::PadPlane(const ParamContainer *)", "PadPlane0001", FatalException, "No pad is defined.");
+
+    const G4double cellSize = params->GetParamD("cellSize")*mm;
+    BuildLookupGrid(cellSize > 0. ? cellSize : padSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PadPlane::~PadPlane()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PadPlane::FindPad(G4double x, G4double y) const
+{
+    const G4int cell = GetCell(x, y);
+    if(cell < 0)
+        return -1;
+    const G4int *pads = GetCellPads(cell);
+    const G4int nbOfPads = GetNbOfCellPads(cell);
+    for(G4int i = 0;i < nbOfPads;++i)
+        if(IsInside(pads[i], x, y))
+            return pads[i];
+    return -1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PadPlane::FindPads(const G4double *x, const G4double *y, G4int n, G4int *pads) const
+{
+    for(G4int i = 0;i < n;++i)
+        pads[i] = FindPad(x[i], y[i]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PadPlane::GetCell(G4double x, G4double y) const
+{
+    const G4double cellX = std::floor((x - fGridX0)/fCellSize);
+    const G4double cellY = std::floor((y - fGridY0)/fCellSize);
+    if(cellX < 0. || cellX >= fNbOfCellsX || cellY < 0. || cellY >= fNbOfCellsY)
+        return -1;
+    return static_cast<G4int>(cellY)*fNbOfCellsX + static_cast<G4int>(cellX);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PadPlane::GetCellRange(G4double xMin, G4double xMax, G4double yMin, G4double yMax, G4int *range) const
+{
+    const G4double cellX0 = std::floor((xMin - fGridX0)/fCellSize);
+    const G4double cellX1 = std::floor((xMax - fGridX0)/fCellSize);
+    const G4double cellY0 = std::floor((yMin - fGridY0)/fCellSize);
+    const G4double cellY1 = std::floor((yMax - fGridY0)/fCellSize);
+    if(cellX1 < 0. || cellX0 >= fNbOfCellsX || cellY1 < 0. || cellY0 >= fNbOfCellsY)
+        return false;
+    range[0] = static_cast<G4int>(std::max(0., cellX0));
+    range[1] = static_cast<G4int>(std::min(fNbOfCellsX - 1., cellX1));
+    range[2] = static_cast<G4int>(std::max(0., cellY0));
+    range[3] = static_cast<G4int>(std::min(fNbOfCellsY - 1., cellY1));
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PadPlane::AddPad(const G4double *x, const G4double *y, G4int nbOfVertices)
+{
+    // signed area to store vertices counterclockwise
+    G4double area = 0., cx = 0., cy = 0.;
+    for(G4int i = 0;i < nbOfVertices;++i)
+    {
+        const G4int j = (i + 1)%nbOfVertices;
+        area += x[i]*y[j] - x[j]*y[i];
+        cx += x[i];
+        cy += y[i];
+    }
+    for(G4int i = 0;i < kMaxNbOfVertices;++i)
+    {
+        // unused vertices repeat the last one, which makes a degenerate edge.
+        const G4int k = std::min(i, nbOfVertices - 1);
+        const G4int v = area >= 0. ? k : nbOfVertices - 1 - k;
+        fVertexX.push_back(fCenterX0 + x[v]);
+        fVertexY.push_back(fCenterY0 + y[v]);
+    }
+    fNbOfVertices.push_back(nbOfVertices);
+    fCenterX.push_back(fCenterX0 + cx/nbOfVertices);
+    fCenterY.push_back(fCenterY0 + cy/nbOfVertices);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PadPlane::GenerateTriangular(G4double radius, G4double side)
+{
+    // rows of alternating up and down triangles, keeping those inside the disk
+    const G4double height = side*std::sqrt(3.)/2.;
+    const G4int nbOfRows = std::ceil(radius/height);
+    const G4int nbOfColumns = std::ceil(radius/side) + 1;
+    for(G4int row = -nbOfRows;row < nbOfRows;++row)
+    {
+        const G4double y0 = row*height, y1 = y0 + height;
+        // shift every other row by half a side so that triangles tile the plane
+        const G4double shift = (row%2 == 0) ? 0. : side/2.;
+        for(G4int col = -nbOfColumns;col <= nbOfColumns;++col)
+        {
+            const G4double x0 = col*side + shift;
+            const G4double up[2][3] = {{x0, x0 + side, x0 + side/2.}, {y0, y0, y1}};
+            const G4double down[2][3] = {{x0 + side/2., x0 + 1.5*side, x0 + side}, {y1, y1, y0}};
+            for(auto triangle : {up, down})
+            {
+                G4bool inside = true;
+                for(G4int i = 0;i < 3;++i)
+                    inside = inside && std::hypot(triangle[0][i], triangle[1][i]) <= radius;
+                if(inside)
+                    AddPad(triangle[0], triangle[1], 3);
+            }
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PadPlane::GenerateHexagonal(G4double radius, G4double side)
+{
+    // pointy-top hexagons on a lattice, keeping those inside the disk
+    const G4double dx = side*std::sqrt(3.), dy = 1.5*side;
+    const G4int nbOfRows = std::ceil(radius/dy) + 1;
+    const G4int nbOfColumns = std::ceil(radius/dx) + 1;
+    for(G4int row = -nbOfRows;row <= nbOfRows;++row)
+    {
+        const G4double shift = (row%2 == 0) ? 0. : dx/2.;
+        for(G4int col = -nbOfColumns;col <= nbOfColumns;++col)
+        {
+            const G4double cx = col*dx + shift, cy = row*dy;
+            if(std::hypot(cx, cy) + side > radius)
+                continue;
+            G4double x[6], y[6];
+            for(G4int i = 0;i < 6;++i)
+            {
+                const G4double angle = (60.*i + 30.)*deg;
+                x[i] = cx + side*std::cos(angle);
+                y[i] = cy + side*std::sin(angle);
+            }
+            AddPad(x, y, 6);
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PadPlane::BuildLookupGrid(G4double cellSize)
+{
+    const auto xRange = std::minmax_element(fVertexX.begin(), fVertexX.end());
+    const auto yRange = std::minmax_element(fVertexY.begin(), fVertexY.end());
+    fCellSize = cellSize;
+    fGridX0 = *xRange.first;
+    fGridY0 = *yRange.first;
+    fNbOfCellsX = std::max(1, static_cast<G4int>(std::ceil((*xRange.second - fGridX0)/fCellSize)));
+    fNbOfCellsY = std::max(1, static_cast<G4int>(std::ceil((*yRange.second - fGridY0)/fCellSize)));
+
+    // range of cells overlapped by the bounding box of a pad
+    auto cellRange = [this](G4int pad, G4int *range)
+    {
+        const auto first = kMaxNbOfVertices*pad, last = first + kMaxNbOfVertices;
+        const auto x = std::minmax_element(fVertexX.begin() + first, fVertexX.begin() + last);
+        const auto y = std::minmax_element(fVertexY.begin() + first, fVertexY.begin() + last);
+        GetCellRange(*x.first, *x.second, *y.first, *y.second, range);
+    };
+
+    // count pads of cells, then fill them in compressed rows
+    const G4int nbOfCells = fNbOfCellsX*fNbOfCellsY;
+    fCellStart.assign(nbOfCells + 1, 0);
+    G4int range[4];
+    for(G4int pad = 0;pad < GetNbOfPads();++pad)
+    {
+        cellRange(pad, range);
+        for(G4int cy = range[2];cy <= range[3];++cy)
+            for(G4int cx = range[0];cx <= range[1];++cx)
+                ++fCellStart[cy*fNbOfCellsX + cx + 1];
+    }
+    for(G4int cell = 0;cell < nbOfCells;++cell)
+        fCellStart[cell + 1] += fCellStart[cell];
+    fCellPads.resize(fCellStart[nbOfCells]);
+    std::vector<G4int> filled(fCellStart.begin(), fCellStart.end() - 1);
+    for(G4int pad = 0;pad < GetNbOfPads();++pad)
+    {
+        cellRange(pad, range);
+        for(G4int cy = range[2];cy <= range[3];++cy)
+            for(G4int cx = range[0];cx <= range[1];++cx)
+                fCellPads[filled[cy*fNbOfCellsX + cx]++] = pad;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PadPlane::IsInside(G4int pad, G4double x, G4double y) const
+{
+    // inside a convex polygon if on the left of all its edges
+    const G4double *vx = fVertexX.data() + kMaxNbOfVertices*pad;
+    const G4double *vy = fVertexY.data() + kMaxNbOfVertices*pad;
+    const G4int n = fNbOfVertices[pad];
+    for(G4int i = 0;i < n;++i)
+    {
+        const G4int j = (i + 1 == n) ? 0 : i + 1;
+        if((vx[j] - vx[i])*(y - vy[i]) - (vy[j] - vy[i])*(x - vx[i]) < 0.)
+            return false;
+    }
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
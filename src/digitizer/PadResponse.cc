@@ -0,0 +1,243 @@
+/// \file PadResponse.cc
+/// \brief Implementation of the PadResponse class
+
+#include "digitizer/PadResponse.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+namespace
+{
+    // table of G(d, phi) for d in [0, kMaxDistance] and w = tan(phi)/(1 + |tan(phi)|) in [0, 1],
+    // zero beyond kMaxDistance. G is smooth in w, which is found without trigonometric functions.
+    constexpr G4int kNbOfDistanceBins = 512;
+    constexpr G4int kNbOfAngleBins = 256;
+    constexpr G4double kMaxDistance = 8.;
+    constexpr G4double kTwoPi = 6.283185307179586;
+
+    struct OwensTTable
+    {
+        std::vector<G4double> values;
+
+        OwensTTable() : values((kNbOfDistanceBins + 1)*(kNbOfAngleBins + 1))
+        {
+            // cumulative 4-point Gauss-Legendre quadrature in phi between the bins of w
+            const G4double nodes[4] = {-0.8611363115940526, -0.3399810435848563, 0.3399810435848563, 0.8611363115940526};
+            const G4double weights[4] = {0.3478548451374538, 0.6521451548625461, 0.6521451548625461, 0.3478548451374538};
+            auto angle = [](G4int j)
+            {
+                const G4double w = static_cast<G4double>(j)/kNbOfAngleBins;
+                return std::atan2(w, 1. - w);
+            };
+            for(G4int i = 0;i <= kNbOfDistanceBins;++i)
+            {
+                const G4double d = kMaxDistance*i/kNbOfDistanceBins;
+                G4double *row = values.data() + i*(kNbOfAngleBins + 1);
+                row[0] = 0.;
+                for(G4int j = 0;j < kNbOfAngleBins;++j)
+                {
+                    const G4double phi0 = angle(j), phi1 = angle(j + 1);
+                    G4double sum = 0.;
+                    for(G4int k = 0;k < 4;++k)
+                    {
+                        const G4double cosPsi = std::cos(phi0 + 0.5*(phi1 - phi0)*(1. + nodes[k]));
+                        sum += weights[k]*std::exp(-0.5*d*d/(cosPsi*cosPsi));
+                    }
+                    row[j + 1] = row[j] + 0.5*(phi1 - phi0)*sum/kTwoPi;
+                }
+            }
+        }
+    };
+
+    const OwensTTable &GetOwensTTable()
+    {
+        // initialized once by the first thread, and read only afterwards
+        static const OwensTTable table;
+        return table;
+    }
+
+    // bilinear interpolation, odd in w
+    inline G4double InterpolateOwensT(const OwensTTable &table, G4double d, G4double w)
+    {
+        if(d >= kMaxDistance)
+            return 0.;
+        const G4double binD = d*(kNbOfDistanceBins/kMaxDistance);
+        const G4double binW = std::min(std::abs(w), 1.)*kNbOfAngleBins;
+        const G4int i = std::min(static_cast<G4int>(binD), kNbOfDistanceBins - 1);
+        const G4int j = std::min(static_cast<G4int>(binW), kNbOfAngleBins - 1);
+        const G4double fd = binD - i, fw = binW - j;
+        const G4double *row0 = table.values.data() + i*(kNbOfAngleBins + 1);
+        const G4double *row1 = row0 + kNbOfAngleBins + 1;
+        const G4double value = (1. - fd)*((1. - fw)*row0[j] + fw*row0[j + 1])
+            + fd*((1. - fw)*row1[j] + fw*row1[j + 1]);
+        return w < 0. ? -value : value;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PadResponse::PadResponse(const PadPlane *padPlane, G4double cloudRange)
+    : fPadPlane(padPlane), fCloudRange(cloudRange), fMinSigma(0.),
+    fPadMinX(), fPadMaxX(), fPadMinY(), fPadMaxY(),
+    fVisited(padPlane->GetNbOfPads(), -1), fVisitId(0)
+{
+    const G4int nbOfPads = fPadPlane->GetNbOfPads();
+    fPadMinX.assign(nbOfPads, DBL_MAX);
+    fPadMaxX.assign(nbOfPads, -DBL_MAX);
+    fPadMinY.assign(nbOfPads, DBL_MAX);
+    fPadMaxY.assign(nbOfPads, -DBL_MAX);
+    G4double minPadSize = DBL_MAX;
+    for(G4int pad = 0;pad < nbOfPads;++pad)
+    {
+        for(G4int i = 0;i < fPadPlane->GetNbOfVertices(pad);++i)
+        {
+            fPadMinX[pad] = std::min(fPadMinX[pad], fPadPlane->GetVertexX(pad, i));
+            fPadMaxX[pad] = std::max(fPadMaxX[pad], fPadPlane->GetVertexX(pad, i));
+            fPadMinY[pad] = std::min(fPadMinY[pad], fPadPlane->GetVertexY(pad, i));
+            fPadMaxY[pad] = std::max(fPadMaxY[pad], fPadPlane->GetVertexY(pad, i));
+        }
+        minPadSize = std::min(minPadSize, std::min(fPadMaxX[pad] - fPadMinX[pad], fPadMaxY[pad] - fPadMinY[pad]));
+    }
+    // clouds much smaller than pads are collected as points.
+    fMinSigma = 1e-3*minPadSize;
+    GetOwensTTable();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PadResponse::~PadResponse()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PadResponse::Collect(const ChargeClusters &clusters, PadCharges &padCharges, ClusterSignals *signals)
+{
+    G4int range[4];
+    for(G4int i = 0;i < clusters.Size();++i)
+    {
+        const G4double charge = clusters.charge[i];
+        const G4double x0 = clusters.x[i], y0 = clusters.y[i], sigma = clusters.sigma[i];
+        if(charge <= 0.)
+            continue;
+        if(sigma < fMinSigma)
+        {
+            const G4int pad = fPadPlane->FindPad(x0, y0);
+            if(pad >= 0)
+                AddCharge(i, pad, charge, padCharges, signals);
+            continue;
+        }
+
+        const G4double xMin = x0 - fCloudRange*sigma, xMax = x0 + fCloudRange*sigma;
+        const G4double yMin = y0 - fCloudRange*sigma, yMax = y0 + fCloudRange*sigma;
+        if(!fPadPlane->GetCellRange(xMin, xMax, yMin, yMax, range))
+            continue;
+        if(++fVisitId == INT_MAX)
+        {
+            std::fill(fVisited.begin(), fVisited.end(), -1);
+            fVisitId = 0;
+        }
+        const G4int nbOfCellsX = fPadPlane->GetNbOfCellsX();
+        for(G4int cy = range[2];cy <= range[3];++cy)
+        {
+            for(G4int cx = range[0];cx <= range[1];++cx)
+            {
+                const G4int cell = cy*nbOfCellsX + cx;
+                const G4int *pads = fPadPlane->GetCellPads(cell);
+                const G4int nbOfPads = fPadPlane->GetNbOfCellPads(cell);
+                for(G4int j = 0;j < nbOfPads;++j)
+                {
+                    const G4int pad = pads[j];
+                    if(fVisited[pad] == fVisitId)
+                        continue;
+                    fVisited[pad] = fVisitId;
+                    if(fPadMaxX[pad] < xMin || fPadMinX[pad] > xMax || fPadMaxY[pad] < yMin || fPadMinY[pad] > yMax)
+                        continue;
+                    const G4double fraction = Integrate(pad, x0, y0, sigma);
+                    if(fraction > 0.)
+                        AddCharge(i, pad, charge*fraction, padCharges, signals);
+                }
+            }
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PadResponse::AddCharge(G4int cluster, G4int pad, G4double charge, PadCharges &padCharges, ClusterSignals *signals) const
+{
+    const G4int index = padCharges.GetIndex(pad);
+    padCharges.charge[index] += charge;
+    if(signals)
+        signals->Append(cluster, index, charge);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PadResponse::Integrate(G4int pad, G4double x0, G4double y0, G4double sigma) const
+{
+    // The angle terms of the triangles add up to the winding number of the pad around the center,
+    // so only G is left for each edge. A center on the boundary has the angle of the pad seen from it,
+    // 1/2 on an edge and the interior angle over 2 pi at a vertex, as the triangles of the edges through it are empty.
+    const auto &table = GetOwensTTable();
+    const G4int n = fPadPlane->GetNbOfVertices(pad);
+    const G4double invSigma = 1./sigma;
+    G4bool inside = true, onBoundary = false;
+    G4double sum = 0.;
+    for(G4int i = 0;i < n;++i)
+    {
+        // edge from vertex 1 to vertex 2 relative to the center of the cloud, in units of sigma
+        const G4int j = (i + 1 == n) ? 0 : i + 1;
+        const G4double x1 = (fPadPlane->GetVertexX(pad, i) - x0)*invSigma;
+        const G4double y1 = (fPadPlane->GetVertexY(pad, i) - y0)*invSigma;
+        const G4double x2 = (fPadPlane->GetVertexX(pad, j) - x0)*invSigma;
+        const G4double y2 = (fPadPlane->GetVertexY(pad, j) - y0)*invSigma;
+        const G4double cross = x1*y2 - x2*y1;
+        inside = inside && cross >= 0.;
+        const G4double ex = x2 - x1, ey = y2 - y1;
+        const G4double length = std::sqrt(ex*ex + ey*ey);
+        // the triangle is empty if the edge is degenerate or its line passes through the center,
+        // and G vanishes far from the edge.
+        if(length <= 0.)
+            continue;
+        if(cross == 0.)
+        {
+            onBoundary = onBoundary || x1*x2 + y1*y2 <= 0.;
+            continue;
+        }
+        const G4double d = std::abs(cross)/length;
+        if(d >= kMaxDistance)
+            continue;
+
+        // positions of the vertices along the edge from the foot of the normal
+        const G4double t1 = (x1*ex + y1*ey)/length, t2 = (x2*ex + y2*ey)/length;
+        const G4double g = InterpolateOwensT(table, d, t2/(d + std::abs(t2)))
+            - InterpolateOwensT(table, d, t1/(d + std::abs(t1)));
+        sum += cross > 0. ? g : -g;
+    }
+    if(!onBoundary)
+        return (inside ? 1. : 0.) - sum;
+    G4double angle = 0.;
+    for(G4int i = 0;i < n;++i)
+    {
+        const G4int j = (i + 1 == n) ? 0 : i + 1;
+        const G4double x1 = (fPadPlane->GetVertexX(pad, i) - x0)*invSigma;
+        const G4double y1 = (fPadPlane->GetVertexY(pad, i) - y0)*invSigma;
+        const G4double x2 = (fPadPlane->GetVertexX(pad, j) - x0)*invSigma;
+        const G4double y2 = (fPadPlane->GetVertexY(pad, j) - y0)*invSigma;
+        const G4double cross = x1*y2 - x2*y1;
+        if(cross != 0.)
+            angle += std::atan2(cross, x1*x2 + y1*y2);
+    }
+    return angle/kTwoPi - sum;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PadResponse::OwensT(G4double d, G4double w)
+{
+    return InterpolateOwensT(GetOwensTTable(), d, w);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,147 @@
+/// \file PolyaGainTable.cc
+/// \brief Implementation of the PolyaGainTable class
+
+#include "digitizer/PolyaGainTable.hh"
+
+#include "G4Exception.hh"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::shared_ptr<const PolyaGainTable> PolyaGainTable::Get(G4double theta)
+{
+    static std::mutex mutex;
+    static std::map<G4double, std::shared_ptr<const PolyaGainTable>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &table = tables[theta];
+    if(!table)
+        table = std::make_shared<const PolyaGainTable>(theta);
+    return table;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PolyaGainTable::PolyaGainTable(G4double theta)
+    : fTheta(theta), fBinWidth(0.), fProbability(), fAlias()
+{
+    if(fTheta < 0.)
+    {
+        std::ostringstream message;
+        message << "Polya theta " << theta << " is negative, the exponential distribution is used.";
+        G4Exception("PolyaGainTable::PolyaGainTable(G4double)", "Digitizer0007", JustWarning, message);
+        fTheta = 0.;
+    }
+
+    // relative gain is gamma distributed with shape k and mean 1, whose tail beyond
+    // 1 + 16/sqrt(k) is below 1e-7 for any k >= 1.
+    const G4double k = 1. + fTheta;
+    const G4double maxGain = 1. + 16./std::sqrt(k);
+    const G4double binWidth = maxGain/kNbOfBins;
+    std::vector<G4double> mass(kNbOfBins);
+    G4double lower = 0., sum = 0., mean = 0.;
+    for(G4int i = 0;i < kNbOfBins;++i)
+    {
+        const G4double upper = IncompleteGamma(k, k*(i + 1)*binWidth);
+        mass[i] = upper - lower;
+        lower = upper;
+        sum += mass[i];
+        mean += mass[i]*(i + 0.5);
+    }
+    for(auto &m : mass)
+        m /= sum;
+    // the bin width is adjusted so that the mean of the table is exactly one.
+    fBinWidth = sum/mean;
+    BuildAliases(mass);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PolyaGainTable::~PolyaGainTable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PolyaGainTable::SampleSum(const G4double *u, G4int n) const
+{
+    G4double sum = 0.;
+    for(G4int i = 0;i < n;++i)
+        sum += Sample(u[i]);
+    return sum;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PolyaGainTable::BuildAliases(std::vector<G4double> &mass)
+{
+    // Vose's method : bins below the average are topped up by bins above it.
+    fProbability.assign(kNbOfBins, 1.);
+    fAlias.resize(kNbOfBins);
+    std::vector<G4int> small, large;
+    for(G4int i = 0;i < kNbOfBins;++i)
+    {
+        fAlias[i] = i;
+        mass[i] *= kNbOfBins;
+        (mass[i] < 1. ? small : large).push_back(i);
+    }
+    while(!small.empty() && !large.empty())
+    {
+        const G4int s = small.back(), l = large.back();
+        small.pop_back();
+        fProbability[s] = mass[s];
+        fAlias[s] = l;
+        mass[l] -= 1. - mass[s];
+        if(mass[l] < 1.)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // bins left in either list are full up to rounding errors, and keep probability one.
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PolyaGainTable::IncompleteGamma(G4double a, G4double x)
+{
+    if(x <= 0.)
+        return 0.;
+    const G4double epsilon = 1e-15;
+    const G4double logPrefactor = -x + a*std::log(x) - std::lgamma(a);
+    if(x < a + 1.)
+    {
+        // series
+        G4double term = 1./a, sum = term;
+        for(G4int n = 1;n < 1000 && std::abs(term) > std::abs(sum)*epsilon;++n)
+        {
+            term *= x/(a + n);
+            sum += term;
+        }
+        return sum*std::exp(logPrefactor);
+    }
+    // continued fraction of the upper function by the modified Lentz's method
+    const G4double tiny = 1e-300;
+    G4double b = x + 1. - a, c = 1./tiny, d = 1./b, h = d;
+    for(G4int n = 1;n < 1000;++n)
+    {
+        const G4double an = -n*(n - a);
+        b += 2.;
+        d = an*d + b;
+        if(std::abs(d) < tiny)
+            d = tiny;
+        c = b + an/c;
+        if(std::abs(c) < tiny)
+            c = tiny;
+        d = 1./d;
+        const G4double delta = d*c;
+        h *= delta;
+        if(std::abs(delta - 1.) < epsilon)
+            break;
+    }
+    return 1. - std::exp(logPrefactor)*h;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,43 @@
+/// \file SparseWaveforms.cc
+/// \brief Implementation of the SparseWaveforms struct
+
+#include "digitizer/SparseWaveforms.hh"
+
+#include <algorithm>
+#include <numeric>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SparseWaveforms::Encode(const ReadoutSamples &readout)
+{
+    Clear();
+    // readout pads are in the order of their first signal.
+    order.resize(readout.Size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&readout](G4int a, G4int b) { return readout.pads[a] < readout.pads[b]; });
+
+    for(auto index : order)
+    {
+        // the readout has no pad without sample.
+        G4int nbOfPadRanges = 0;
+        G4int lastBucket = -2;
+        for(G4int i = readout.first[index];i < readout.first[index + 1];++i)
+        {
+            const G4int bucket = readout.buckets[i];
+            if(bucket == lastBucket + 1 && nbOfPadRanges > 0)
+                ++rangeLength.back();
+            else
+            {
+                rangeStart.push_back(bucket);
+                rangeLength.push_back(1);
+                ++nbOfPadRanges;
+            }
+            samples.push_back(readout.samples[i]);
+            lastBucket = bucket;
+        }
+        pads.push_back(readout.pads[index]);
+        nbOfRanges.push_back(nbOfPadRanges);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,179 @@
+/// \file WaveformGenerator.cc
+/// \brief Implementation of the WaveformGenerator class
+
+#include "digitizer/WaveformGenerator.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Exception.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WaveformGenerator::WaveformGenerator(const ParamContainer *params)
+    : fNbOfTimeBuckets(params->GetParamI("nbOfTimeBuckets")),
+    fBucketWidth(1./(params->GetParamD("samplingFrequency")*MHz)),
+    fTriggerDelay(params->GetParamD("triggerDelay")*microsecond),
+    fKernel(), fBinnedCharge(), fTimeSpread()
+{
+    BuildKernel(params->GetParamS("shaping"), params->GetParamD("peakingTime")*microsecond, params->GetParamI("shapingOrder"));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WaveformGenerator::~WaveformGenerator()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WaveformGenerator::BuildKernel(const G4String &shaping, G4double peakingTime, G4int order)
+{
+    // response as a function of x = t/tau, and the x beyond which it is ignored
+    std::function<G4double(G4double)> response;
+    G4double maxX = 0.;
+    if(shaping == "aget")
+    {
+        // the negative lobes after the first half period are negligible.
+        response = [](G4double x) { return std::exp(-3.*x)*x*x*x*std::sin(x); };
+        maxX = pi;
+    }
+    else if(shaping == "crrc")
+    {
+        response = [order](G4double x) { return std::pow(x, order)*std::exp(-x); };
+        maxX = DBL_MAX;
+    }
+    else
+    {
+        std::ostringstream message;
+        message << "Unknown shaping response " << shaping << ".";
+        G4Exception("WaveformGenerator::BuildKernel()", "Digitizer0002", FatalException, message);
+        return;
+    }
+
+    // peak of the response on a fine grid, to scale tau to the peaking time
+    G4double peakX = 0., peak = 0.;
+    for(G4int i = 1;i <= 100000;++i)
+    {
+        const G4double x = 1e-4*i*std::min(maxX, 2.*order + 10.);
+        const G4double r = response(x);
+        if(r > peak)
+        {
+            peak = r;
+            peakX = x;
+        }
+    }
+    const G4double tau = peakingTime/peakX;
+
+    // sample at bucket centers until the tail after the peak falls below 1e-5 of the peak
+    fKernel.clear();
+    for(G4int i = 0;i < fNbOfTimeBuckets;++i)
+    {
+        const G4double x = (i + 0.5)*fBucketWidth/tau;
+        if(x > maxX)
+            break;
+        const G4double r = response(x)/peak;
+        if(x > peakX && r < 1e-5)
+            break;
+        fKernel.push_back(r);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WaveformGenerator::Generate(DigitizerEvent &event)
+{
+    const G4int nbOfSamples = event.padCharges.Size()*fNbOfTimeBuckets;
+    event.waveforms.nbOfBuckets = fNbOfTimeBuckets;
+    event.waveforms.samples.assign(nbOfSamples, 0.f);
+    fBinnedCharge.assign(nbOfSamples, 0.f);
+
+    BinElectrons(event.electrons, event.padCharges);
+    BinClusters(event.clusters, event.clusterSignals);
+    for(G4int i = 0;i < event.padCharges.Size();++i)
+        Convolve(fBinnedCharge.data() + i*fNbOfTimeBuckets, event.waveforms.GetWaveform(i));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WaveformGenerator::BinElectrons(const DriftElectrons &electrons, const PadCharges &padCharges)
+{
+    const G4double invWidth = 1./fBucketWidth;
+    for(G4int i = 0;i < electrons.Size();++i)
+    {
+        const G4int pad = electrons.pad[i];
+        const G4double bucket = std::floor((electrons.t[i] - fTriggerDelay)*invWidth);
+        if(pad < 0 || bucket < 0. || bucket >= fNbOfTimeBuckets)
+            continue;
+        fBinnedCharge[padCharges.indexOfPad[pad]*fNbOfTimeBuckets + static_cast<G4int>(bucket)] += 1.f;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WaveformGenerator::BinClusters(const ChargeClusters &clusters, const ClusterSignals &signals)
+{
+    // Charge of a cluster is spread over buckets within 3 sigma of its time.
+    // Signals of a cluster are consecutive, so the spread is computed once per cluster.
+    const G4double invWidth = 1./fBucketWidth;
+    auto cdf = [](G4double u) { return 0.5*std::erfc(-u/std::sqrt(2.)); };
+    G4int currentCluster = -1, first = 0, last = -1;
+    for(G4int i = 0;i < signals.Size();++i)
+    {
+        const G4int cluster = signals.cluster[i];
+        if(cluster != currentCluster)
+        {
+            currentCluster = cluster;
+            const G4double t = clusters.t[cluster] - fTriggerDelay, sigma = clusters.sigmaTime[cluster];
+            fTimeSpread.clear();
+            if(sigma < 0.1*fBucketWidth)
+            {
+                first = last = static_cast<G4int>(std::min(std::max(std::floor(t*invWidth), -1.), 1.*fNbOfTimeBuckets));
+                fTimeSpread.push_back(1.f);
+            }
+            else
+            {
+                first = std::max(0., std::floor((t - 3.*sigma)*invWidth));
+                last = std::min(fNbOfTimeBuckets - 1., std::floor((t + 3.*sigma)*invWidth));
+                G4double lower = cdf((first*fBucketWidth - t)/sigma);
+                for(G4int bucket = first;bucket <= last;++bucket)
+                {
+                    const G4double upper = cdf(((bucket + 1)*fBucketWidth - t)/sigma);
+                    fTimeSpread.push_back(upper - lower);
+                    lower = upper;
+                }
+            }
+        }
+        if(first < 0 || last >= fNbOfTimeBuckets)
+            continue;
+        G4float *__restrict binned = fBinnedCharge.data() + signals.padIndex[i]*fNbOfTimeBuckets + first;
+        const G4float *__restrict spread = fTimeSpread.data();
+        const G4float q = signals.charge[i];
+        for(G4int k = 0;k <= last - first;++k)
+            binned[k] += q*spread[k];
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WaveformGenerator::Convolve(const G4float *charge, G4float *waveform) const
+{
+    const G4int kernelLength = fKernel.size();
+    const G4float *__restrict kernel = fKernel.data();
+    for(G4int bucket = 0;bucket < fNbOfTimeBuckets;++bucket)
+    {
+        const G4float q = charge[bucket];
+        if(q == 0.f)
+            continue;
+        G4float *__restrict out = waveform + bucket;
+        const G4int n = std::min(kernelLength, fNbOfTimeBuckets - bucket);
+        for(G4int k = 0;k < n;++k)
+            out[k] += q*kernel[k];
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,121 @@
+/// \file WaveformReadout.cc
+/// \brief Implementation of the WaveformReadout class
+
+#include "digitizer/WaveformReadout.hh"
+
+#include "G4Exception.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WaveformReadout::WaveformReadout(const ParamContainer *params, G4int nbOfPads)
+    : fMode(kPartial), fNoiseSigma(params->GetParamD("noiseSigma")),
+    fThresholds(nbOfPads, params->GetParamD("threshold")), fGaussians()
+{
+    const G4String mode = params->GetParamS("readoutMode");
+    if(mode == "full")
+        fMode = kFull;
+    else if(mode == "partial")
+        fMode = kPartial;
+    else if(mode == "zero")
+        fMode = kZeroSuppression;
+    else
+    {
+        std::ostringstream message;
+        message << "Unknown readout mode " << mode << ".";
+        G4Exception("WaveformReadout::WaveformReadout()", "Digitizer0003", FatalException, message);
+    }
+    const G4String thresholdFile = params->GetParamS("thresholdFile");
+    if(thresholdFile != "none")
+        ReadThresholdFile(thresholdFile);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WaveformReadout::~WaveformReadout()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WaveformReadout::ReadThresholdFile(const G4String &fileName)
+{
+    std::ifstream fileIn(fileName.data());
+    if(!fileIn.is_open())
+    {
+        std::ostringstream message;
+        message << "Cannot open the threshold file " << fileName << ".";
+        G4Exception("WaveformReadout::ReadThresholdFile()", "Digitizer0004", FatalException, message);
+        return;
+    }
+    std::string line;
+    while(std::getline(fileIn, line))
+    {
+        line = line.substr(0, line.find('#'));
+        std::stringstream ss(line);
+        G4int pad;
+        G4double threshold;
+        if(!(ss >> pad >> threshold))
+            continue;
+        if(pad < 0 || pad >= static_cast<G4int>(fThresholds.size()))
+        {
+            std::ostringstream message;
+            message << "Threshold of pad " << pad << " out of the pad plane is ignored.";
+            G4Exception("WaveformReadout::ReadThresholdFile()", "Digitizer0005", JustWarning, message);
+            continue;
+        }
+        fThresholds[pad] = threshold;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WaveformReadout::Read(DigitizerEvent &event, CLHEP::HepRandomEngine &engine)
+{
+    auto &waveforms = event.waveforms;
+    auto &readout = event.readout;
+    readout.Clear();
+    if(fNoiseSigma > 0.)
+        AddNoise(waveforms, engine);
+
+    const G4int nbOfBuckets = waveforms.nbOfBuckets;
+    for(G4int i = 0;i < waveforms.Size();++i)
+    {
+        const G4int pad = event.padCharges.pads[i];
+        const G4float *waveform = waveforms.GetWaveform(i);
+        const G4float threshold = fThresholds[pad];
+        if(fMode == kZeroSuppression)
+        {
+            for(G4int bucket = 0;bucket < nbOfBuckets;++bucket)
+                if(waveform[bucket] > threshold)
+                    readout.Append(bucket, waveform[bucket]);
+        }
+        else if(fMode == kFull || *std::max_element(waveform, waveform + nbOfBuckets) > threshold)
+        {
+            for(G4int bucket = 0;bucket < nbOfBuckets;++bucket)
+                readout.Append(bucket, waveform[bucket]);
+        }
+        readout.ClosePad(pad);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WaveformReadout::AddNoise(PadWaveforms &waveforms, CLHEP::HepRandomEngine &engine)
+{
+    // all gaussian numbers of the event in one batch
+    const G4int nbOfSamples = waveforms.samples.size();
+    if(nbOfSamples == 0)
+        return;
+    fGaussians.resize(nbOfSamples);
+    CLHEP::RandGaussQ::shootArray(&engine, nbOfSamples, fGaussians.data());
+    G4float *__restrict samples = waveforms.samples.data();
+    const G4double *__restrict gaussians = fGaussians.data();
+    const G4float sigma = fNoiseSigma;
+    for(G4int i = 0;i < nbOfSamples;++i)
+        samples[i] += sigma*static_cast<G4float>(gaussians[i]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -7,6 +7,10 @@
 #include "G4ios.hh"
 #include "G4UnitsTable.hh"
 #include "G4PrimaryParticle.hh"
+#include "G4Exception.hh"
+
+#include <cmath>
+#include <limits>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -16,15 +20,20 @@ G4ThreadLocal G4Allocator<GasChamberHit> *GasChamberHitAllocator;
 
 GasChamberHit::GasChamberHit()
     : G4VHit(),
-    fEventId(-1), fTrackId(-1), fZ(0),
-    fEdepSum(0), fTrackLen(0)
+    fSteps(nullptr),
+    fEventId(-1), fTrackId(-1), fZ(0), fNbOfStepPoints(0),
+    fEdepSum(0), fTrackLen(0),
+    fMergeOpen(false), fMergeDir(), fMergeDedx(0), fMergeValues()
 {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-GasChamberHit::GasChamberHit(const G4DynamicParticle *pDynamic, G4int evtId, G4int trkId)
+GasChamberHit::GasChamberHit(const G4DynamicParticle *pDynamic, G4int evtId, G4int trkId,
+    GasChamberStepStore::Slot *steps)
     : G4VHit(),
-    fEdepSum(0), fTrackLen(0), fMass(0), fPartName()
+    fSteps(steps), fNbOfStepPoints(0),
+    fEdepSum(0), fTrackLen(0), fMass(0), fPartName(),
+    fMergeOpen(false), fMergeDir(), fMergeDedx(0), fMergeValues()
 {
     auto pDef = pDynamic->GetDefinition();
     SetPartName(pDef->GetParticleName());
@@ -44,44 +53,40 @@ GasChamberHit::~GasChamberHit()
 GasChamberHit::GasChamberHit(const GasChamberHit &right)
     : G4VHit()
 {
-    fPosX = right.GetPosX();
-    fPosY = right.GetPosY();
-    fPosZ = right.GetPosZ();
-    fMomX = right.GetMomX();
-    fMomY = right.GetMomY();
-    fMomZ = right.GetMomZ();
-    fEdep = right.GetEdep();
-    fTime = right.GetTime();
-    fCharge = right.GetCharge();
+    // a copy refers to the same slot of the step store.
+    fSteps = right.fSteps;
     fEventId = right.GetEventId();
+    fTrackId = right.GetTrackId();
     fZ = right.GetAtomicNumber();
     fNbOfStepPoints = right.GetNbOfStepPoints();
     fEdepSum = right.GetEdepSum();
     fTrackLen = right.GetTrackLength();
     fMass = right.GetMass();
     fPartName = right.GetPartName();
+    fMergeOpen = right.fMergeOpen;
+    fMergeDir = right.fMergeDir;
+    fMergeDedx = right.fMergeDedx;
+    fMergeValues = right.fMergeValues;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 const GasChamberHit &GasChamberHit::operator=(const GasChamberHit &right)
 {
-    fPosX = right.GetPosX();
-    fPosY = right.GetPosY();
-    fPosZ = right.GetPosZ();
-    fMomX = right.GetMomX();
-    fMomY = right.GetMomY();
-    fMomZ = right.GetMomZ();
-    fEdep = right.GetEdep();
-    fTime = right.GetTime();
-    fCharge = right.GetCharge();
+    // a copy refers to the same slot of the step store.
+    fSteps = right.fSteps;
     fEventId = right.GetEventId();
+    fTrackId = right.GetTrackId();
     fZ = right.GetAtomicNumber();
     fNbOfStepPoints = right.GetNbOfStepPoints();
     fEdepSum = right.GetEdepSum();
     fTrackLen = right.GetTrackLength();
     fMass = right.GetMass();
     fPartName = right.GetPartName();
+    fMergeOpen = right.fMergeOpen;
+    fMergeDir = right.fMergeDir;
+    fMergeDedx = right.fMergeDedx;
+    fMergeValues = right.fMergeValues;
     return *this;
 }
 
@@ -89,15 +94,7 @@ const GasChamberHit &GasChamberHit::operator=(const GasChamberHit &right)
 
 G4bool GasChamberHit::operator==(const GasChamberHit &right) const
 {
-    return fPosX == right.GetPosX() &&
-    fPosY == right.GetPosY() &&
-    fPosZ == right.GetPosZ() &&
-    fMomX == right.GetMomX() &&
-    fMomY == right.GetMomY() &&
-    fMomZ == right.GetMomZ() &&
-    fEdep == right.GetEdep() &&
-    fTime == right.GetTime() &&
-    fCharge == right.GetCharge() &&
+    return fSteps == right.fSteps &&
     fEventId == right.GetEventId() &&
     fZ == right.GetAtomicNumber() &&
     fNbOfStepPoints == right.GetNbOfStepPoints() &&
@@ -111,18 +108,42 @@ G4bool GasChamberHit::operator==(const GasChamberHit &right) const
 
 void GasChamberHit::Print()
 {
+    using Store = GasChamberStepStore;
+    // columns not recorded are printed as "-".
+    auto printValue = [this](Store::Column col, G4int j, G4int width, const char *unitCategory)
+    {
+        if(j >= GetNbOfStepValues(col))
+            G4cout << std::setw(width) << "-";
+        else if(unitCategory)
+            G4cout << std::setw(width) << G4BestUnit(GetStepValue(col, j), unitCategory);
+        else
+            G4cout << std::setw(width) << GetStepValue(col, j);
+    };
+    const G4bool hasMomentum = GetNbOfStepValues(Store::kMomX) > 0
+        && GetNbOfStepValues(Store::kMomY) > 0 && GetNbOfStepValues(Store::kMomZ) > 0;
     for(int j = 0;j < GetNbOfStepPoints();++j)
     {
-        G4ThreeVector mom(fMomX.at(j), fMomY.at(j), fMomZ.at(j));
-        G4cout << std::setw(10) << std::right << G4BestUnit(fPosX.at(j), "Length")
-            << std::setw(10) << G4BestUnit(fPosY.at(j), "Length")
-            << std::setw(10) << G4BestUnit(fPosZ.at(j), "Length")
-            << std::setw(12) << mom.getX()/mom.mag()
-            << std::setw(10) << mom.getY()/mom.mag()
-            << std::setw(10) << mom.getZ()/mom.mag()
-            << std::setw(10) << G4BestUnit(fEdep.at(j), "Energy")
-            << std::setw(10) << G4BestUnit(sqrt(mom.mag2() + fMass*fMass) - fMass, "Energy")
-            << std::setw(10) << fCharge.at(j) << G4endl;
+        G4cout << std::right;
+        printValue(Store::kPosX, j, 10, "Length");
+        printValue(Store::kPosY, j, 10, "Length");
+        printValue(Store::kPosZ, j, 10, "Length");
+        if(hasMomentum)
+        {
+            G4ThreeVector mom(GetStepValue(Store::kMomX, j), GetStepValue(Store::kMomY, j), GetStepValue(Store::kMomZ, j));
+            G4cout << std::setw(12) << mom.getX()/mom.mag()
+                << std::setw(10) << mom.getY()/mom.mag()
+                << std::setw(10) << mom.getZ()/mom.mag();
+            printValue(Store::kEdep, j, 10, "Energy");
+            G4cout << std::setw(10) << G4BestUnit(sqrt(mom.mag2() + fMass*fMass) - fMass, "Energy");
+        }
+        else
+        {
+            G4cout << std::setw(12) << "-" << std::setw(10) << "-" << std::setw(10) << "-";
+            printValue(Store::kEdep, j, 10, "Energy");
+            G4cout << std::setw(10) << "-";
+        }
+        printValue(Store::kCharge, j, 10, nullptr);
+        G4cout << G4endl;
     }
     G4cout << "--------------------------------------------------------------------------------------------------------------------------------" << G4endl;
     G4cout << std::setw(40) << std::left << "Total Track Length : " << std::setw(10) << std::right << G4BestUnit(fTrackLen, "Length") << G4endl;
@@ -132,51 +153,112 @@ void GasChamberHit::Print()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void GasChamberHit::AppendEdep(G4double de)
-{
-    fEdep.push_back(de);
-}
-
-//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
-
-void GasChamberHit::AppendTime(G4double t)
+G4double GasChamberHit::GetStepValue(GasChamberStepStore::Column col, G4int i) const
 {
-    fTime.push_back(t);
+    const auto &storage = GasChamberStepStore::GetColumnStorage(col);
+    switch(storage.type)
+    {
+        case GasChamberStepStore::kFloat:
+            return fSteps->columnsF[col][i];
+        case GasChamberStepStore::kFixedPoint:
+            return fSteps->columnsI[col][i]*storage.scale;
+        default:
+            return fSteps->columns[col][i];
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void GasChamberHit::AppendCharge(G4double q)
+G4int GasChamberHit::GetNbOfStepValues(GasChamberStepStore::Column col) const
 {
-    fCharge.push_back(q);
+    switch(GasChamberStepStore::GetColumnStorage(col).type)
+    {
+        case GasChamberStepStore::kFloat:
+            return fSteps->columnsF[col].size();
+        case GasChamberStepStore::kFixedPoint:
+            return fSteps->columnsI[col].size();
+        default:
+            return fSteps->columns[col].size();
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void GasChamberHit::AppendPosition(const G4ThreeVector &pos)
+void GasChamberHit::AppendStep(const G4double *values, const std::vector<GasChamberStepStore::Column> &columns)
 {
-    fPosX.push_back(pos[0]);
-    fPosY.push_back(pos[1]);
-    fPosZ.push_back(pos[2]);
+    for(auto col : columns)
+    {
+        const auto &storage = GasChamberStepStore::GetColumnStorage(col);
+        switch(storage.type)
+        {
+            case GasChamberStepStore::kFloat:
+                fSteps->columnsF[col].push_back(values[col]);
+                break;
+            case GasChamberStepStore::kFixedPoint:
+                fSteps->columnsI[col].push_back(ToFixedPoint(values[col], storage.scale));
+                fMergeValues[col] = values[col];
+                break;
+            default:
+                fSteps->columns[col].push_back(values[col]);
+        }
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void GasChamberHit::AppendMomentum(const G4ThreeVector &mom)
+void GasChamberHit::MergeStep(const G4double *values, const std::vector<GasChamberStepStore::Column> &columns)
 {
-    fMomX.push_back(mom[0]);
-    fMomY.push_back(mom[1]);
-    fMomZ.push_back(mom[2]);
+    // The merged point keeps the convention of the post step point of its last step.
+    for(auto col : columns)
+    {
+        const auto &storage = GasChamberStepStore::GetColumnStorage(col);
+        const G4bool additive = GasChamberStepStore::IsAdditive(col);
+        switch(storage.type)
+        {
+            case GasChamberStepStore::kFloat:
+            {
+                auto &value = fSteps->columnsF[col].back();
+                value = additive ? value + values[col] : values[col];
+                break;
+            }
+            case GasChamberStepStore::kFixedPoint:
+            {
+                // additive values are summed before rounding, so that the rounding error does not accumulate.
+                auto &sum = fMergeValues[col];
+                sum = additive ? sum + values[col] : values[col];
+                fSteps->columnsI[col].back() = ToFixedPoint(sum, storage.scale);
+                break;
+            }
+            default:
+            {
+                auto &value = fSteps->columns[col].back();
+                value = additive ? value + values[col] : values[col];
+            }
+        }
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void GasChamberHit::AppendStepLen(G4double stepLen)
+G4int GasChamberHit::ToFixedPoint(G4double value, G4double scale)
 {
-    fStepLen.push_back(stepLen);
+    static G4ThreadLocal G4bool warned = false;
+    const G4double scaled = std::round(value/scale);
+    constexpr G4double maxValue = std::numeric_limits<G4int>::max();
+    constexpr G4double minValue = std::numeric_limits<G4int>::min();
+    if(scaled <= maxValue && scaled >= minValue)
+        return static_cast<G4int>(scaled);
+    if(!warned)
+    {
+        G4ExceptionDescription message;
+        message << "A step value of " << value << " overflows its fixed point column with scale " << scale
+            << ", clamped to the range of G4int. Use a larger scale for the column. Further overflows are not reported.";
+        G4Exception("GasChamberHit::ToFixedPoint(G4double, G4double)", "GasChamberHit0000", JustWarning, message);
+        warned = true;
+    }
+    return scaled > 0 ? std::numeric_limits<G4int>::max() : std::numeric_limits<G4int>::min();
 }
 
-
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void GasChamberHit::AddEdepSum(G4double de)
@@ -233,4 +315,83 @@ void GasChamberHit::SetNbOfStepPoints(G4int nStep)
     fNbOfStepPoints = nStep;
 }
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::AddNbOfStepPoints(G4int nStep)
+{
+    fNbOfStepPoints += nStep;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::OpenMergePoint(const G4ThreeVector &dir, G4double dedx)
+{
+    fMergeOpen = true;
+    fMergeDir = dir;
+    fMergeDedx = dedx;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::SwapStepColumn(GasChamberStepStore::Column col, std::vector<G4double> &other)
+{
+    StepColumn(col).swap(other);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::SwapStepColumn(GasChamberStepStore::Column col, std::vector<G4float> &other)
+{
+    fSteps->columnsF[col].swap(other);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::SwapStepColumn(GasChamberStepStore::Column col, std::vector<G4int> &other)
+{
+    fSteps->columnsI[col].swap(other);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::CopyStepColumn(GasChamberStepStore::Column col, std::vector<G4double> &other) const
+{
+    other.assign(fSteps->columns[col].begin(), fSteps->columns[col].end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::CopyStepColumn(GasChamberStepStore::Column col, std::vector<G4float> &other) const
+{
+    other.assign(fSteps->columnsF[col].begin(), fSteps->columnsF[col].end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::CopyStepColumn(GasChamberStepStore::Column col, std::vector<G4int> &other) const
+{
+    other.assign(fSteps->columnsI[col].begin(), fSteps->columnsI[col].end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::AppendStepColumn(GasChamberStepStore::Column col, std::vector<G4double> &other) const
+{
+    other.insert(other.end(), fSteps->columns[col].begin(), fSteps->columns[col].end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::AppendStepColumn(GasChamberStepStore::Column col, std::vector<G4float> &other) const
+{
+    other.insert(other.end(), fSteps->columnsF[col].begin(), fSteps->columnsF[col].end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberHit::AppendStepColumn(GasChamberStepStore::Column col, std::vector<G4int> &other) const
+{
+    other.insert(other.end(), fSteps->columnsI[col].begin(), fSteps->columnsI[col].end());
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
\ No newline at end of file
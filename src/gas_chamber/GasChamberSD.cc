@@ -3,6 +3,7 @@
 
 #include "gas_chamber/GasChamberSD.hh"
 #include "gas_chamber/GasChamberHit.hh"
+#include "config/ParamContainerTable.hh"
 
 #include "G4HCofThisEvent.hh"
 #include "G4TouchableHistory.hh"
@@ -16,14 +17,28 @@
 #include "G4SystemOfUnits.hh"
 #include "G4UnitsTable.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 GasChamberSD::GasChamberSD(G4String name, G4int verbose)
     : G4VSensitiveDetector(name),
-    fHitsCollection(nullptr), fMessenger(nullptr), fHCID(-1), fEventId(-1), fTrackId(-1),
-    fNbOfStepPoints(0)
+    fHitsCollection(nullptr), fStepStore(nullptr), fMessenger(nullptr), fFilterMessenger(nullptr), fHCID(-1), fEventId(-1), fTrackId(-1),
+    fCurrentHit(nullptr), fHitIndexOfTrack(kInitialNbOfTrackIds, -1), fMaxTrackId(0),
+    fRecordedColumns(), fRecordMomentum(false),
+    fMergeSteps(false), fMergeCosMaxAngle(1.),
+    fMergeMaxDedxChange(0.05), fMergeFullResolutionRange(5.*mm), fEmCalculator(),
+    fFilterParticles(), fFilterChargedOnly(false), fFilterMinKineticEnergy(0.),
+    fFilterMaxParentId(-1), fFilterPrimaryOnly(false),
+    fSubStepMode(kSubStepOff), fSubStepLength(0.5*mm), fSubStepEnergy(1.*keV), fMaxNbOfSubSteps(100)
 {
     verboseLevel = verbose;
+    fStepStore = new GasChamberStepStore;
+    // by default, record the columns written to the ntuple.
+    SetColumns(ParamContainerTable::GetContainer("gas_chamber")->GetParamS("columns"));
+    SetMergeMaxAngle(1.*deg);
     collectionName.insert("GasChamberHColl");
     DefineCommands();
 }
@@ -32,7 +47,9 @@ GasChamberSD::GasChamberSD(G4String name, G4int verbose)
 
 GasChamberSD::~GasChamberSD()
 {
+    delete fStepStore;
     delete fMessenger;
+    delete fFilterMessenger;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -46,18 +63,19 @@ void GasChamberSD::Initialize(G4HCofThisEvent *hce)
     }
     hce->AddHitsCollection(fHCID, fHitsCollection);
 
-    fNbOfStepPoints = 0;
+    // hits of the previous event have been deleted with its hits collection.
+    fStepStore->Reset();
     fEventId = G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID();
     fTrackId = -1;
+    fCurrentHit = nullptr;
+    std::fill(fHitIndexOfTrack.begin(), fHitIndexOfTrack.begin() + fMaxTrackId + 1, -1);
+    fMaxTrackId = 0;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void GasChamberSD::EndOfEvent(G4HCofThisEvent *)
 {
-    // fill the # of the step points of the last track if more than one.
-    if(fHitsCollection->GetSize() > 0)
-        (*fHitsCollection)[fHitsCollection->GetSize() - 1]->SetNbOfStepPoints(fNbOfStepPoints);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -66,34 +84,355 @@ G4bool GasChamberSD::ProcessHits(G4Step *step, G4TouchableHistory *)
 {
     const auto track = step->GetTrack();
     const auto pDynamic = step->GetTrack()->GetDynamicParticle();
-    // if new track
+    // look up the hit only if the track has changed since the last step.
     if(fTrackId != track->GetTrackID())
     {
-        if(fHitsCollection->GetSize() > 0)
-            (*fHitsCollection)[fHitsCollection->GetSize() - 1]->SetNbOfStepPoints(fNbOfStepPoints);
-        fNbOfStepPoints = 0;
         fTrackId = track->GetTrackID();
-        fHitsCollection->insert(new GasChamberHit(pDynamic, fEventId, fTrackId));
+        fCurrentHit = FindOrCreateHit(step);
+    }
+    auto hit = fCurrentHit;
+    if(!hit)
+        return false;
+
+    // only the selected columns are filled in the buffer and appended to the hit.
+    G4double values[GasChamberStepStore::kNbOfColumns];
+    const auto &pos = track->GetPosition();
+    values[GasChamberStepStore::kPosX] = pos[0];
+    values[GasChamberStepStore::kPosY] = pos[1];
+    values[GasChamberStepStore::kPosZ] = pos[2];
+    if(fRecordMomentum)
+    {
+        const auto mom = track->GetMomentum();
+        values[GasChamberStepStore::kMomX] = mom[0];
+        values[GasChamberStepStore::kMomY] = mom[1];
+        values[GasChamberStepStore::kMomZ] = mom[2];
+    }
+    values[GasChamberStepStore::kEdep] = step->GetTotalEnergyDeposit();
+    values[GasChamberStepStore::kTime] = track->GetGlobalTime();
+    values[GasChamberStepStore::kCharge] = pDynamic->GetCharge();
+    values[GasChamberStepStore::kStepLen] = step->GetStepLength();
+
+    if(!fMergeSteps)
+    {
+        const G4int nbOfSubSteps = GetNbOfSubSteps(step);
+        if(nbOfSubSteps > 1)
+            AppendSubSteps(step, hit, values, nbOfSubSteps);
+        else
+        {
+            hit->AppendStep(values, fRecordedColumns);
+            hit->AddNbOfStepPoints(1);
+        }
     }
-    auto hit = (*fHitsCollection)[fHitsCollection->GetSize() - 1];
-    hit->AppendPosition(track->GetPosition());
-    hit->AppendMomentum(track->GetMomentum());
-    hit->AppendEdep(step->GetTotalEnergyDeposit());
-    hit->AppendCharge(pDynamic->GetCharge());
-    hit->AppendTime(track->GetGlobalTime());
-    hit->AppendStepLen(step->GetStepLength());
+    else
+    {
+        const auto dir = step->GetDeltaPosition().unit();
+        const G4double dedx = step->GetStepLength() > 0. ? step->GetTotalEnergyDeposit()/step->GetStepLength() : 0.;
+        if(IsMergeable(step, hit, dir, dedx))
+            hit->MergeStep(values, fRecordedColumns);
+        else
+        {
+            hit->AppendStep(values, fRecordedColumns);
+            hit->AddNbOfStepPoints(1);
+            hit->OpenMergePoint(dir, dedx);
+        }
+    }
+    // sums are kept exact regardless of merging.
     hit->AddEdepSum(step->GetTotalEnergyDeposit());
     hit->AddTrackLength(step->GetStepLength());
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-    ++fNbOfStepPoints;
+GasChamberHit *GasChamberSD::FindOrCreateHit(const G4Step *step)
+{
+    // A track can be stepped in several pieces, e.g. if it is suspended or
+    // leaves and reenters the chamber, so it is recorded in the hit created at its first step.
+    const auto track = step->GetTrack();
+    const G4int trackId = track->GetTrackID();
+    if(trackId >= static_cast<G4int>(fHitIndexOfTrack.size()))
+        fHitIndexOfTrack.resize(2*trackId, -1);
+    fMaxTrackId = std::max(fMaxTrackId, trackId);
+
+    G4int &index = fHitIndexOfTrack[trackId];
+    if(index == kRejectedTrack)
+        return nullptr;
+    if(index < 0)
+    {
+        if(!AcceptTrack(step))
+        {
+            index = kRejectedTrack;
+            return nullptr;
+        }
+        auto hit = new GasChamberHit(track->GetDynamicParticle(), fEventId, trackId, fStepStore->AcquireSlot());
+        index = fHitsCollection->insert(hit) - 1;
+    }
+    return (*fHitsCollection)[index];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool GasChamberSD::AcceptTrack(const G4Step *step) const
+{
+    const auto track = step->GetTrack();
+    if(fFilterPrimaryOnly && track->GetParentID() != 0)
+        return false;
+    if(fFilterMaxParentId >= 0 && track->GetParentID() > fFilterMaxParentId)
+        return false;
+    if(fFilterChargedOnly && track->GetDynamicParticle()->GetCharge() == 0.)
+        return false;
+    if(step->GetPreStepPoint()->GetKineticEnergy() < fFilterMinKineticEnergy)
+        return false;
+    if(!fFilterParticles.empty())
+    {
+        const auto &name = track->GetParticleDefinition()->GetParticleName();
+        if(std::find(fFilterParticles.begin(), fFilterParticles.end(), name) == fFilterParticles.end())
+            return false;
+    }
     return true;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+G4bool GasChamberSD::IsMergeable(const G4Step *step, const GasChamberHit *hit,
+    const G4ThreeVector &dir, G4double dedx)
+{
+    // a step is never merged into a point of the previous passage through the chamber.
+    if(!hit->IsMergePointOpen() || step->IsFirstStepInVolume() || step->GetStepLength() <= 0.)
+        return false;
+    if(dir.dot(hit->GetMergeDirection()) < fMergeCosMaxAngle)
+        return false;
+    const G4double dedxRef = hit->GetMergeDedx();
+    if(std::abs(dedx - dedxRef) > fMergeMaxDedxChange*dedxRef)
+        return false;
+
+    // full resolution near the end of range, where the Bragg peak is.
+    // Checked last since the range lookup is the most expensive.
+    const auto postStepPoint = step->GetPostStepPoint();
+    if(postStepPoint->GetCharge() != 0.)
+    {
+        const G4double range = fEmCalculator.GetRangeFromRestricteDEDX(postStepPoint->GetKineticEnergy(),
+            step->GetTrack()->GetParticleDefinition(), step->GetPreStepPoint()->GetMaterial());
+        if(range < fMergeFullResolutionRange)
+            return false;
+    }
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int GasChamberSD::GetNbOfSubSteps(const G4Step *step) const
+{
+    G4double nbOfSubSteps = 1.;
+    if(fSubStepMode == kSubStepLength)
+        nbOfSubSteps = std::ceil(step->GetStepLength()/fSubStepLength);
+    else if(fSubStepMode == kSubStepDedx)
+        nbOfSubSteps = std::ceil(step->GetTotalEnergyDeposit()/fSubStepEnergy);
+    return std::max(1, static_cast<G4int>(std::min<G4double>(nbOfSubSteps, fMaxNbOfSubSteps)));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberSD::AppendSubSteps(const G4Step *step, GasChamberHit *hit, G4double *values, G4int nbOfSubSteps)
+{
+    const auto preStepPoint = step->GetPreStepPoint();
+    const auto postStepPoint = step->GetPostStepPoint();
+    const auto &prePos = preStepPoint->GetPosition();
+    const auto deltaPos = postStepPoint->GetPosition() - prePos;
+    const G4double preTime = preStepPoint->GetGlobalTime();
+    const G4double deltaTime = postStepPoint->GetGlobalTime() - preTime;
+    G4ThreeVector preMom, deltaMom;
+    if(fRecordMomentum)
+    {
+        preMom = preStepPoint->GetMomentum();
+        deltaMom = postStepPoint->GetMomentum() - preMom;
+    }
+
+    // each point takes an equal share of the deposit and length at the midpoint of its segment,
+    // since points at the segment ends would shift the deposit by half a segment towards the post step point.
+    values[GasChamberStepStore::kEdep] /= nbOfSubSteps;
+    values[GasChamberStepStore::kStepLen] /= nbOfSubSteps;
+    for(G4int i = 1;i <= nbOfSubSteps;++i)
+    {
+        const G4double fraction = (i - 0.5)/nbOfSubSteps;
+        const auto pos = prePos + fraction*deltaPos;
+        values[GasChamberStepStore::kPosX] = pos[0];
+        values[GasChamberStepStore::kPosY] = pos[1];
+        values[GasChamberStepStore::kPosZ] = pos[2];
+        values[GasChamberStepStore::kTime] = preTime + fraction*deltaTime;
+        if(fRecordMomentum)
+        {
+            const auto mom = preMom + fraction*deltaMom;
+            values[GasChamberStepStore::kMomX] = mom[0];
+            values[GasChamberStepStore::kMomY] = mom[1];
+            values[GasChamberStepStore::kMomZ] = mom[2];
+        }
+        hit->AppendStep(values, fRecordedColumns);
+    }
+    hit->AddNbOfStepPoints(nbOfSubSteps);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberSD::SetMergeSteps(G4bool merge)
+{
+    if(merge && fSubStepMode != kSubStepOff)
+    {
+        G4Exception("GasChamberSD::SetMergeSteps(G4bool)", "GasChamberSD0000", JustWarning,
+            "Step merging and sub-steps are exclusive, sub-steps are turned off.");
+        fSubStepMode = kSubStepOff;
+    }
+    fMergeSteps = merge;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberSD::SetSubStepMode(const G4String &mode)
+{
+    if(mode == "length")
+        fSubStepMode = kSubStepLength;
+    else if(mode == "dedx")
+        fSubStepMode = kSubStepDedx;
+    else
+        fSubStepMode = kSubStepOff;
+    if(fSubStepMode != kSubStepOff && fMergeSteps)
+    {
+        G4Exception("GasChamberSD::SetSubStepMode(const G4String &)", "GasChamberSD0000", JustWarning,
+            "Step merging and sub-steps are exclusive, step merging is turned off.");
+        fMergeSteps = false;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberSD::SetMergeMaxAngle(G4double angle)
+{
+    fMergeCosMaxAngle = std::cos(angle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberSD::SetColumns(const G4String &columnList)
+{
+    auto mask = GasChamberStepStore::ParseColumns(columnList);
+    fRecordedColumns = GasChamberStepStore::ToColumnList(mask);
+    fRecordMomentum = mask.test(GasChamberStepStore::kMomX)
+        || mask.test(GasChamberStepStore::kMomY) || mask.test(GasChamberStepStore::kMomZ);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberSD::SetFilterParticles(const G4String &particleList)
+{
+    fFilterParticles.clear();
+    std::string list = particleList;
+    std::replace(list.begin(), list.end(), ',', ' ');
+    std::stringstream ss(list);
+    std::string name;
+    while(ss >> name)
+    {
+        if(name == "all")
+        {
+            fFilterParticles.clear();
+            return;
+        }
+        fFilterParticles.push_back(name);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberSD::ResetFilters()
+{
+    fFilterParticles.clear();
+    fFilterChargedOnly = false;
+    fFilterMinKineticEnergy = 0.;
+    fFilterMaxParentId = -1;
+    fFilterPrimaryOnly = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void GasChamberSD::DefineCommands()
 {
     fMessenger = new G4GenericMessenger(this, "/attpc/gasChamber/", "Gas Chamger SD control");
     // auto fVerboseCmd = fMessenger->DeclareProperty("verbose", verboseLevel, "Set verbosity");
     fMessenger->DeclareProperty("verbose", verboseLevel, "Set verbosity");
+
+    auto columnsCmd = fMessenger->DeclareMethod("columns", &GasChamberSD::SetColumns,
+        "Select step columns to be recorded, separated by commas (x,y,z,px,py,pz,eDep,t,q,stepLen, all or none).");
+    columnsCmd.SetParameterName("columnList", false);
+    columnsCmd.SetGuidance("Columns not booked by \"columns\" in parameters/gas_chamber.txt are recorded but not written.");
+
+    auto mergeCmd = fMessenger->DeclareMethod("mergeSteps", &GasChamberSD::SetMergeSteps,
+        "Merge consecutive steps of a track into one step point within tolerances.");
+    mergeCmd.SetGuidance("Total energy deposit and track length of tracks are kept exact.");
+    mergeCmd.SetParameterName("merge", true);
+    mergeCmd.SetDefaultValue("true");
+
+    auto angleCmd = fMessenger->DeclareMethodWithUnit("mergeMaxAngle", "deg", &GasChamberSD::SetMergeMaxAngle,
+        "Maximum change of direction within a merged step point.");
+    angleCmd.SetParameterName("angle", false);
+    angleCmd.SetRange("angle >= 0");
+
+    auto dedxCmd = fMessenger->DeclareProperty("mergeMaxDedxChange", fMergeMaxDedxChange,
+        "Maximum relative change of dE/dx within a merged step point.");
+    dedxCmd.SetParameterName("change", false);
+    dedxCmd.SetRange("change >= 0");
+
+    auto rangeCmd = fMessenger->DeclarePropertyWithUnit("mergeFullResolutionRange", "mm", fMergeFullResolutionRange,
+        "Steps are not merged once the residual range of a charged track is below this value.");
+    rangeCmd.SetParameterName("range", false);
+    rangeCmd.SetRange("range >= 0");
+
+    auto subStepCmd = fMessenger->DeclareMethod("subSteps", &GasChamberSD::SetSubStepMode,
+        "Distribute the deposit of each step to points along the step.");
+    subStepCmd.SetGuidance("  off    : one point at the post step point");
+    subStepCmd.SetGuidance("  length : one point per subStepLength of the step");
+    subStepCmd.SetGuidance("  dedx   : one point per subStepEnergy of the deposit");
+    subStepCmd.SetParameterName("mode", false);
+    subStepCmd.SetCandidates("off length dedx");
+
+    auto subStepLengthCmd = fMessenger->DeclarePropertyWithUnit("subStepLength", "mm", fSubStepLength,
+        "Spacing of points along a step in length mode of sub-steps.");
+    subStepLengthCmd.SetParameterName("length", false);
+    subStepLengthCmd.SetRange("length > 0");
+
+    auto subStepEnergyCmd = fMessenger->DeclarePropertyWithUnit("subStepEnergy", "keV", fSubStepEnergy,
+        "Energy deposit per point in dedx mode of sub-steps.");
+    subStepEnergyCmd.SetParameterName("energy", false);
+    subStepEnergyCmd.SetRange("energy > 0");
+
+    auto maxSubStepCmd = fMessenger->DeclareProperty("maxSubSteps", fMaxNbOfSubSteps,
+        "Maximum number of points per step.");
+    maxSubStepCmd.SetParameterName("nPoints", false);
+    maxSubStepCmd.SetRange("nPoints > 0");
+
+    fFilterMessenger = new G4GenericMessenger(this, "/attpc/gasChamber/filter/", "Track filters of gas chamber SD");
+    fFilterMessenger->SetGuidance("Filters are applied at the first step of a track in the chamber.");
+
+    auto particlesCmd = fFilterMessenger->DeclareMethod("particles", &GasChamberSD::SetFilterParticles,
+        "Record only tracks of given particles, separated by commas (e.g. alpha,C12, or all).");
+    particlesCmd.SetParameterName("particleList", false);
+
+    auto chargedCmd = fFilterMessenger->DeclareProperty("chargedOnly", fFilterChargedOnly,
+        "Record only charged tracks.");
+    chargedCmd.SetParameterName("charged", true);
+    chargedCmd.SetDefaultValue("true");
+
+    auto kinECmd = fFilterMessenger->DeclarePropertyWithUnit("minKineticEnergy", "keV", fFilterMinKineticEnergy,
+        "Record only tracks entering or created in the chamber above this kinetic energy.");
+    kinECmd.SetParameterName("kinE", false);
+    kinECmd.SetRange("kinE >= 0");
+
+    auto parentCmd = fFilterMessenger->DeclareProperty("maxParentId", fFilterMaxParentId,
+        "Record only tracks whose parent ID is not larger than this value, negative to disable.");
+    parentCmd.SetParameterName("parentId", false);
+
+    auto primaryCmd = fFilterMessenger->DeclareProperty("primaryOnly", fFilterPrimaryOnly,
+        "Record only primary tracks.");
+    primaryCmd.SetParameterName("primary", true);
+    primaryCmd.SetDefaultValue("true");
+
+    fFilterMessenger->DeclareMethod("reset", &GasChamberSD::ResetFilters, "Remove all track filters.");
 }
\ No newline at end of file
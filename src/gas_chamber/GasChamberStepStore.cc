@@ -0,0 +1,174 @@
+/// \file GasChamberStepStore.cc
+/// \brief Implementation of the GasChamberStepStore class
+
+#include "gas_chamber/GasChamberStepStore.hh"
+
+#include "config/ParamContainerTable.hh"
+
+#include "G4Exception.hh"
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+    const std::array<G4String, GasChamberStepStore::kNbOfColumns> kColumnNames = {
+        "x", "y", "z", "px", "py", "pz", "eDep", "t", "q", "stepLen"};
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberStepStore::GasChamberStepStore()
+    : fSlots(), fNbOfSlotsInUse(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberStepStore::~GasChamberStepStore()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberStepStore::Slot *GasChamberStepStore::AcquireSlot()
+{
+    // allocate a new slot only if all existing ones are in use in this event.
+    // Columns grow on their first use, so columns never recorded take no memory.
+    if(fNbOfSlotsInUse == static_cast<G4int>(fSlots.size()))
+        fSlots.emplace_back();
+    return &fSlots[fNbOfSlotsInUse++];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberStepStore::Reset()
+{
+    // clear() keeps the capacity of the buffers.
+    for(G4int i = 0;i < fNbOfSlotsInUse;++i)
+    {
+        for(auto &column : fSlots[i].columns)
+            column.clear();
+        for(auto &column : fSlots[i].columnsF)
+            column.clear();
+        for(auto &column : fSlots[i].columnsI)
+            column.clear();
+    }
+    fNbOfSlotsInUse = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const G4String &GasChamberStepStore::GetColumnName(Column col)
+{
+    return kColumnNames[col];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberStepStore::ColumnMask GasChamberStepStore::ParseColumns(const G4String &columnList)
+{
+    ColumnMask mask;
+    std::string list = columnList;
+    std::replace(list.begin(), list.end(), ',', ' ');
+    std::stringstream ss(list);
+    std::string token;
+    while(ss >> token)
+    {
+        if(token == "all")
+        {
+            mask.set();
+            continue;
+        }
+        else if(token == "none")
+        {
+            mask.reset();
+            continue;
+        }
+        auto found = std::find(kColumnNames.begin(), kColumnNames.end(), token);
+        if(found == kColumnNames.end())
+        {
+            std::ostringstream message;
+            message << "Unknown step column " << token << " is ignored.";
+            G4Exception("GasChamberStepStore::ParseColumns(const G4String &)", "GasChamberStep0000", JustWarning, message);
+        }
+        else
+            mask.set(found - kColumnNames.begin());
+    }
+    return mask;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<GasChamberStepStore::Column> GasChamberStepStore::ToColumnList(const ColumnMask &mask)
+{
+    std::vector<Column> columns;
+    for(G4int col = 0;col < kNbOfColumns;++col)
+        if(mask.test(col))
+            columns.push_back(static_cast<Column>(col));
+    return columns;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const GasChamberStepStore::ColumnStorage &GasChamberStepStore::GetColumnStorage(Column col)
+{
+    // parameters are loaded before any thread starts, and the table is never changed afterwards.
+    static const auto storageTable = ParseStorage(
+        ParamContainerTable::GetContainer("gas_chamber")->GetParamS("storage"));
+    return storageTable[col];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::array<GasChamberStepStore::ColumnStorage, GasChamberStepStore::kNbOfColumns>
+    GasChamberStepStore::ParseStorage(const G4String &storageList)
+{
+    std::array<ColumnStorage, kNbOfColumns> table;
+    table.fill({kDouble, 1.});
+
+    std::string list = storageList;
+    std::replace(list.begin(), list.end(), ',', ' ');
+    std::stringstream ss(list);
+    std::string token;
+    while(ss >> token)
+    {
+        // column:type[:scale]
+        std::string name, type;
+        G4double scale = 1.;
+        std::stringstream tokenStream(token);
+        std::getline(tokenStream, name, ':');
+        std::getline(tokenStream, type, ':');
+        std::string scaleStr;
+        G4bool valid = true;
+        if(std::getline(tokenStream, scaleStr, ':'))
+        {
+            std::stringstream scaleStream(scaleStr);
+            valid = static_cast<G4bool>(scaleStream >> scale) && scale > 0.;
+        }
+
+        ColumnStorage storage{kDouble, scale};
+        if(type == "double")
+            storage.type = kDouble;
+        else if(type == "float")
+            storage.type = kFloat;
+        else if(type == "int")
+            storage.type = kFixedPoint;
+        else
+            valid = false;
+
+        auto found = std::find(kColumnNames.begin(), kColumnNames.end(), name);
+        if(!valid || (name != "all" && found == kColumnNames.end()))
+        {
+            std::ostringstream message;
+            message << "Invalid storage specification " << token << " is ignored.";
+            G4Exception("GasChamberStepStore::ParseStorage(const G4String &)", "GasChamberStep0001", JustWarning, message);
+            continue;
+        }
+        if(name == "all")
+            table.fill(storage);
+        else
+            table[found - kColumnNames.begin()] = storage;
+    }
+    return table;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
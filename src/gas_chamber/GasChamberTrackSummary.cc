@@ -0,0 +1,65 @@
+/// \file GasChamberTrackSummary.cc
+/// \brief Implementation of the GasChamberTrackSummary struct
+
+#include "gas_chamber/GasChamberTrackSummary.hh"
+
+#include "G4ThreeVector.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberTrackSummary::Compute(const GasChamberHit &hit)
+{
+    using Store = GasChamberStepStore;
+    values.fill(0.);
+    const G4int nbOfPoints = hit.GetNbOfStepValues(Store::kPosX);
+    if(nbOfPoints == 0 || hit.GetNbOfStepValues(Store::kPosY) != nbOfPoints
+        || hit.GetNbOfStepValues(Store::kPosZ) != nbOfPoints)
+        return;
+    const G4bool hasEdep = hit.GetNbOfStepValues(Store::kEdep) == nbOfPoints;
+    const G4bool hasStepLen = hit.GetNbOfStepValues(Store::kStepLen) == nbOfPoints;
+
+    const G4ThreeVector first(hit.GetStepValue(Store::kPosX, 0), hit.GetStepValue(Store::kPosY, 0),
+        hit.GetStepValue(Store::kPosZ, 0));
+    G4ThreeVector last = first;
+    G4double pathLen = 0., braggDedx = 0., braggPos = 0.;
+    for(G4int i = 0;i < nbOfPoints;++i)
+    {
+        const G4ThreeVector pos(hit.GetStepValue(Store::kPosX, i), hit.GetStepValue(Store::kPosY, i),
+            hit.GetStepValue(Store::kPosZ, i));
+        const G4double stepLen = hasStepLen ? hit.GetStepValue(Store::kStepLen, i) : (pos - last).mag();
+        pathLen += stepLen;
+        if(hasEdep && stepLen > 0.)
+        {
+            const G4double dedx = hit.GetStepValue(Store::kEdep, i)/stepLen;
+            if(dedx > braggDedx)
+            {
+                braggDedx = dedx;
+                braggPos = pathLen;
+            }
+        }
+        last = pos;
+    }
+
+    values[kBraggPos] = braggPos;
+    values[kBraggDedx] = braggDedx;
+
+    const G4ThreeVector displacement = last - first;
+    const G4double range = displacement.mag();
+    values[kRange] = range;
+    if(range > 0.)
+    {
+        values[kDirX] = displacement.x()/range;
+        values[kDirY] = displacement.y()/range;
+        values[kDirZ] = displacement.z()/range;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const char *GasChamberTrackSummary::GetColumnName(Value value)
+{
+    static const char *names[kNbOfValues] = {"range", "braggPos", "braggDedx", "dirX", "dirY", "dirZ"};
+    return names[value];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,72 @@
+/// \file GasChamberVoxelHit.cc
+/// \brief Implementation of the GasChamberVoxelHit class
+
+#include "gas_chamber/GasChamberVoxelHit.hh"
+
+#include "G4ios.hh"
+#include "G4UnitsTable.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreadLocal G4Allocator<GasChamberVoxelHit> *GasChamberVoxelHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberVoxelHit::GasChamberVoxelHit()
+    : G4VHit(), fEventId(-1), fVoxelMap(nullptr), fEdepOutside(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberVoxelHit::GasChamberVoxelHit(G4int evtId, const GasChamberVoxelMap *voxelMap)
+    : G4VHit(), fEventId(evtId), fVoxelMap(voxelMap), fEdepOutside(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberVoxelHit::GasChamberVoxelHit(const GasChamberVoxelHit &right)
+    : G4VHit()
+{
+    fEventId = right.fEventId;
+    fVoxelMap = right.fVoxelMap;
+    fEdepOutside = right.fEdepOutside;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberVoxelHit::~GasChamberVoxelHit()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const GasChamberVoxelHit &GasChamberVoxelHit::operator=(const GasChamberVoxelHit &right)
+{
+    fEventId = right.fEventId;
+    fVoxelMap = right.fVoxelMap;
+    fEdepOutside = right.fEdepOutside;
+    return *this;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool GasChamberVoxelHit::operator==(const GasChamberVoxelHit &right) const
+{
+    return fEventId == right.fEventId && fVoxelMap == right.fVoxelMap;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberVoxelHit::Print()
+{
+    G4double edepSum = 0.;
+    for(auto edep : fVoxelMap->GetEdeps())
+        edepSum += edep;
+    G4cout << std::setw(40) << std::left << "The # of occupied voxels" << " : "
+        << std::setw(10) << std::right << fVoxelMap->GetNbOfVoxels() << G4endl;
+    G4cout << std::setw(40) << std::left << "Total Energy Deposit in voxels" << " : "
+        << std::setw(10) << std::right << G4BestUnit(edepSum, "Energy") << G4endl;
+    G4cout << std::setw(40) << std::left << "Energy Deposit outside of voxels" << " : "
+        << std::setw(10) << std::right << G4BestUnit(fEdepOutside, "Energy") << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,89 @@
+/// \file GasChamberVoxelMap.cc
+/// \brief Implementation of the GasChamberVoxelMap class
+
+#include "gas_chamber/GasChamberVoxelMap.hh"
+
+#include <cstdint>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberVoxelMap::GasChamberVoxelMap(G4int initialCapacity)
+    : fBuckets(), fMask(0), fVoxelIds(), fEdeps()
+{
+    size_t capacity = 16;
+    while(capacity < static_cast<size_t>(initialCapacity))
+        capacity <<= 1;
+    fBuckets.assign(capacity, -1);
+    fMask = capacity - 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberVoxelMap::~GasChamberVoxelMap()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberVoxelMap::Add(G4int voxelId, G4double edep)
+{
+    size_t bucket = Hash(voxelId);
+    while(fBuckets[bucket] >= 0)
+    {
+        const G4int index = fBuckets[bucket];
+        if(fVoxelIds[index] == voxelId)
+        {
+            fEdeps[index] += edep;
+            return;
+        }
+        bucket = (bucket + 1) & fMask;
+    }
+
+    fBuckets[bucket] = fVoxelIds.size();
+    fVoxelIds.push_back(voxelId);
+    fEdeps.push_back(edep);
+    // keep the load factor below 1/2 so that probe sequences stay short.
+    if(2*fVoxelIds.size() > fBuckets.size())
+        Rehash(2*fBuckets.size());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberVoxelMap::Clear()
+{
+    // Reset only the buckets of occupied voxels, in the reverse order of insertion,
+    // so that the probe sequence of each voxel is still intact when it is removed.
+    for(G4int index = static_cast<G4int>(fVoxelIds.size()) - 1;index >= 0;--index)
+    {
+        size_t bucket = Hash(fVoxelIds[index]);
+        while(fBuckets[bucket] != index)
+            bucket = (bucket + 1) & fMask;
+        fBuckets[bucket] = -1;
+    }
+    fVoxelIds.clear();
+    fEdeps.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+size_t GasChamberVoxelMap::Hash(G4int voxelId) const
+{
+    // Fibonacci hashing spreads neighbouring voxel indices over the table.
+    return (static_cast<std::uint32_t>(voxelId)*UINT64_C(11400714819323198485) >> 20) & fMask;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberVoxelMap::Rehash(size_t capacity)
+{
+    fBuckets.assign(capacity, -1);
+    fMask = capacity - 1;
+    for(size_t index = 0;index < fVoxelIds.size();++index)
+    {
+        size_t bucket = Hash(fVoxelIds[index]);
+        while(fBuckets[bucket] >= 0)
+            bucket = (bucket + 1) & fMask;
+        fBuckets[bucket] = index;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
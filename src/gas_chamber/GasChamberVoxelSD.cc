@@ -0,0 +1,128 @@
+/// \file GasChamberVoxelSD.cc
+/// \brief Implementation of the GasChamberVoxelSD class
+
+#include "gas_chamber/GasChamberVoxelSD.hh"
+#include "config/ParamContainerTable.hh"
+
+#include "G4HCofThisEvent.hh"
+#include "G4TouchableHistory.hh"
+#include "G4Step.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "G4VSolid.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include "G4SDManager.hh"
+#include "G4RunManager.hh"
+
+#include "G4ios.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <climits>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberVoxelSD::GasChamberVoxelSD(G4String name, G4int verbose)
+    : G4VSensitiveDetector(name),
+    fHitsCollection(nullptr), fHit(nullptr), fVoxelMap(nullptr), fHCID(-1),
+    fGridBuilt(false), fGridOrigin(), fVoxelSize{}, fNbOfVoxels{}
+{
+    verboseLevel = verbose;
+    fVoxelMap = new GasChamberVoxelMap;
+
+    const auto params = ParamContainerTable::GetContainer("gas_chamber");
+    const auto voxelSize = params->GetParamVecD("voxelSize");
+    if(voxelSize.size() != 3 || voxelSize[0] <= 0. || voxelSize[1] <= 0. || voxelSize[2] <= 0.)
+        G4Exception("GasChamberVoxelSD::GasChamberVoxelSD(G4String, G4int)", "GasChamberVoxel0000",
+            FatalException, "voxelSize must be three positive numbers.");
+    for(G4int i = 0;i < 3;++i)
+        fVoxelSize[i] = voxelSize[i]*mm;
+
+    collectionName.insert("GasChamberVoxelHColl");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GasChamberVoxelSD::~GasChamberVoxelSD()
+{
+    delete fVoxelMap;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberVoxelSD::Initialize(G4HCofThisEvent *hce)
+{
+    fHitsCollection = new GasChamberVoxelHitsCollection(SensitiveDetectorName, collectionName[0]);
+    if(fHCID < 0)
+    {
+        fHCID = G4SDManager::GetSDMpointer()->GetCollectionID(fHitsCollection);
+    }
+    hce->AddHitsCollection(fHCID, fHitsCollection);
+
+    // the hit of the previous event has been deleted with its hits collection.
+    fVoxelMap->Clear();
+    fHit = new GasChamberVoxelHit(G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID(), fVoxelMap);
+    fHitsCollection->insert(fHit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool GasChamberVoxelSD::ProcessHits(G4Step *step, G4TouchableHistory *)
+{
+    const G4double edep = step->GetTotalEnergyDeposit();
+    if(edep <= 0.)
+        return false;
+    const auto touchable = step->GetPreStepPoint()->GetTouchable();
+    if(!fGridBuilt)
+        BuildGrid(touchable);
+    const auto pos = 0.5*(step->GetPreStepPoint()->GetPosition() + step->GetPostStepPoint()->GetPosition());
+    const G4int voxelId = GetVoxelId(touchable->GetHistory()->GetTopTransform().TransformPoint(pos));
+    if(voxelId < 0)
+        fHit->AddEdepOutside(edep);
+    else
+        fVoxelMap->Add(voxelId, edep);
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GasChamberVoxelSD::BuildGrid(const G4VTouchable *touchable)
+{
+    // The grid is centred on the bounding box of the solid, which may be smaller than a whole number of voxels.
+    G4ThreeVector boxMin, boxMax;
+    touchable->GetSolid()->BoundingLimits(boxMin, boxMax);
+    G4double nbOfVoxelsTotal = 1.;
+    for(G4int i = 0;i < 3;++i)
+    {
+        fNbOfVoxels[i] = std::ceil((boxMax[i] - boxMin[i])/fVoxelSize[i]);
+        nbOfVoxelsTotal *= fNbOfVoxels[i];
+    }
+    if(nbOfVoxelsTotal > INT_MAX)
+        G4Exception("GasChamberVoxelSD::BuildGrid(const G4VTouchable *)", "GasChamberVoxel0001",
+            FatalException, "Too many voxels for 32 bit voxel indices, use larger voxelSize.");
+    fGridOrigin = 0.5*(boxMin + boxMax)
+        - 0.5*G4ThreeVector(fNbOfVoxels[0]*fVoxelSize[0], fNbOfVoxels[1]*fVoxelSize[1], fNbOfVoxels[2]*fVoxelSize[2]);
+    fGridBuilt = true;
+    if(verboseLevel > 0)
+        G4cout << "Voxel grid of " << touchable->GetVolume()->GetName() << " : "
+            << fNbOfVoxels[0] << " x " << fNbOfVoxels[1] << " x " << fNbOfVoxels[2]
+            << " voxels from " << fGridOrigin/mm << " mm in the local frame." << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int GasChamberVoxelSD::GetVoxelId(const G4ThreeVector &localPos) const
+{
+    G4int index[3];
+    for(G4int i = 0;i < 3;++i)
+    {
+        const G4double scaledPos = std::floor((localPos[i] - fGridOrigin[i])/fVoxelSize[i]);
+        if(scaledPos < 0. || scaledPos >= fNbOfVoxels[i])
+            return -1;
+        index[i] = scaledPos;
+    }
+    return (index[2]*fNbOfVoxels[1] + index[1])*fNbOfVoxels[0] + index[0];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
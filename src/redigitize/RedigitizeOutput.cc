@@ -0,0 +1,85 @@
+/// \file RedigitizeOutput.cc
+/// \brief Implementation of the RedigitizeOutput class
+
+#include "redigitize/RedigitizeOutput.hh"
+
+#include "G4Exception.hh"
+
+#include <chrono>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RedigitizeOutput::RedigitizeOutput(const G4String &fileName, const ParamContainer *params,
+    const OutputSettings &settings)
+    : fMutex(), fFile(nullptr), fColumns(params), fTrees(), fWriteTime(0.), fFileId(-1)
+{
+    fFile = TFile::Open(fileName.c_str(), "RECREATE");
+    if(!fFile || fFile->IsZombie())
+    {
+        std::ostringstream message;
+        message << "Output file " << fileName << " cannot be created.";
+        G4Exception("RedigitizeOutput::RedigitizeOutput(const G4String &, const ParamContainer *, const OutputSettings &)", "Redigitize0004",
+            FatalException, message);
+    }
+    settings.Apply(fFile);
+
+    using Column = DigitizerColumns::Column;
+    for(const auto &tree : fColumns.GetTrees())
+    {
+        auto outputTree = new TTree(tree.name.c_str(), tree.title.c_str());
+        for(const auto &column : tree.columns)
+        {
+            if(column.type == Column::kInt)
+                outputTree->Branch(column.name.c_str(), column.value, (column.name + "/I").c_str());
+            else if(column.type == Column::kIntVector)
+                outputTree->Branch(column.name.c_str(), column.ints);
+            else
+                outputTree->Branch(column.name.c_str(), column.floats);
+        }
+        outputTree->Branch("fileId", &fFileId, "fileId/I");
+        settings.Apply(outputTree);
+        fTrees.push_back(outputTree);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RedigitizeOutput::~RedigitizeOutput()
+{
+    Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RedigitizeOutput::Fill(const DigitizerEvent &event, G4int fileId)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    const auto start = std::chrono::steady_clock::now();
+    fFileId = fileId;
+    fColumns.Fill(event);
+    for(auto tree : fTrees)
+        tree->Fill();
+    fWriteTime += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RedigitizeOutput::Close()
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    if(!fFile)
+        return;
+    // trees are owned and deleted by the file.
+    const auto start = std::chrono::steady_clock::now();
+    fFile->Write();
+    fWriteTime += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+    OutputSettings::PrintCompression(fFile->GetName(),
+        OutputSettings::GetTreeSizes(fTrees), fWriteTime, "filling and writing the trees");
+    fFile->Close();
+    delete fFile;
+    fFile = nullptr;
+    fTrees.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,186 @@
+/// \file StepTreeReader.cc
+/// \brief Implementation of the StepTreeReader class
+
+#include "redigitize/StepTreeReader.hh"
+#include "analysis/ShardManifest.hh"
+
+#include "G4Exception.hh"
+
+#include "TBranch.h"
+#include "TClass.h"
+#include "TTreeReaderValue.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepTreeReader::StepTreeReader(const G4String &fileNames, const G4String &storage)
+    : fChain("tree_gc2"), fReader(), fStorage(GasChamberStepStore::ParseStorage(storage)),
+    fPosX(), fPosY(), fPosZ(), fEdep(), fTime()
+{
+    AddFiles(fChain, fileNames);
+    fReader.SetTree(&fChain);
+    BindColumn(GasChamberStepStore::kPosX, fPosX, true);
+    BindColumn(GasChamberStepStore::kPosY, fPosY, true);
+    BindColumn(GasChamberStepStore::kPosZ, fPosZ, true);
+    BindColumn(GasChamberStepStore::kEdep, fEdep, true);
+    BindColumn(GasChamberStepStore::kTime, fTime, false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepTreeReader::~StepTreeReader()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<StepTreeReader::EventEntries> StepTreeReader::BuildIndex(const G4String &fileNames)
+{
+    TChain chain("tree_gc2");
+    AddFiles(chain, fileNames);
+    TTreeReader reader(&chain);
+    TTreeReaderValue<Int_t> eventId(reader, "evtId");
+
+    // Rows of an event are not consecutive if the simulation ran with several threads,
+    // but are in one file, and files of different runs may have the same event ids.
+    std::map<std::pair<G4int, G4int>, std::vector<Long64_t>> entriesOfEvents;
+    while(reader.Next())
+        entriesOfEvents[{chain.GetTreeNumber(), *eventId}].push_back(reader.GetCurrentEntry());
+
+    std::vector<EventEntries> index;
+    index.reserve(entriesOfEvents.size());
+    for(auto &entries : entriesOfEvents)
+        index.push_back({entries.first.first, entries.first.second, std::move(entries.second)});
+    return index;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepTreeReader::ReadEvent(const EventEntries &event, DigitizerSteps &steps)
+{
+    for(auto entry : event.entries)
+    {
+        if(fReader.SetEntry(entry) != TTreeReader::kEntryValid)
+        {
+            std::ostringstream message;
+            message << "Entry " << entry << " of tree_gc2 of event " << event.eventId << " of file " << event.fileId
+                << " cannot be read.";
+            G4Exception("StepTreeReader::ReadEvent(const EventEntries &, DigitizerSteps &)", "Redigitize0002",
+                FatalException, message);
+        }
+        const std::size_t nbOfSteps = fEdep.GetSize();
+        if(fPosX.GetSize() != nbOfSteps || fPosY.GetSize() != nbOfSteps || fPosZ.GetSize() != nbOfSteps)
+            continue;
+        const G4bool hasTime = fTime.IsValid() && fTime.GetSize() == nbOfSteps;
+        for(std::size_t i = 0;i < nbOfSteps;++i)
+            steps.Append(fPosX.Get(i), fPosY.Get(i), fPosZ.Get(i), fEdep.Get(i), hasTime ? fTime.Get(i) : 0.);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepTreeReader::AddFiles(TChain &chain, const G4String &fileNames)
+{
+    std::string list = fileNames;
+    std::replace(list.begin(), list.end(), ',', ' ');
+    std::stringstream ss(list);
+    std::string fileName;
+    while(ss >> fileName)
+    {
+        // shards of a run written without ntuple merging
+        if(ShardManifest::IsManifest(fileName))
+        {
+            for(const auto &shard : ShardManifest::Read(fileName))
+                AddFiles(chain, shard.fileName);
+            continue;
+        }
+        if(chain.Add(fileName.c_str()) == 0)
+        {
+            std::ostringstream message;
+            message << "No tree_gc2 is found in " << fileName << ".";
+            G4Exception("StepTreeReader::AddFiles(TChain &, const G4String &)", "Redigitize0000",
+                FatalException, message);
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepTreeReader::BindColumn(GasChamberStepStore::Column col, StepColumn &column, G4bool required)
+{
+    const auto &name = GasChamberStepStore::GetColumnName(col);
+    TBranch *branch = fChain.GetBranch(name.c_str());
+    TClass *branchClass = nullptr;
+    EDataType dataType;
+    if(branch)
+        branch->GetExpectedType(branchClass, dataType);
+    const std::string className = branchClass ? branchClass->GetName() : "";
+
+    // the type of a column is that of its branch, and only the scale is taken from storage.
+    column.scale = fStorage[col].scale;
+    if(className == "vector<double>")
+    {
+        column.type = GasChamberStepStore::kDouble;
+        column.valuesD = std::make_unique<TTreeReaderArray<Double_t>>(fReader, name.c_str());
+    }
+    else if(className == "vector<float>")
+    {
+        column.type = GasChamberStepStore::kFloat;
+        column.valuesF = std::make_unique<TTreeReaderArray<Float_t>>(fReader, name.c_str());
+    }
+    else if(className == "vector<int>")
+    {
+        column.type = GasChamberStepStore::kFixedPoint;
+        column.valuesI = std::make_unique<TTreeReaderArray<Int_t>>(fReader, name.c_str());
+        if(fStorage[col].type != GasChamberStepStore::kFixedPoint)
+        {
+            std::ostringstream message;
+            message << "Step column " << name << " is stored as int, but no scale is given by storage. "
+                << "Its values are read with the scale of 1.";
+            G4Exception("StepTreeReader::BindColumn(Column, StepColumn &, G4bool)", "Redigitize0003",
+                JustWarning, message);
+        }
+    }
+    else if(required)
+    {
+        std::ostringstream message;
+        message << "Step column " << name << " is not found in tree_gc2. "
+            << "x, y, z and eDep must be in columns of parameters/gas_chamber.txt of the simulation.";
+        G4Exception("StepTreeReader::BindColumn(Column, StepColumn &, G4bool)", "Redigitize0001",
+            FatalException, message);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::size_t StepTreeReader::StepColumn::GetSize() const
+{
+    switch(type)
+    {
+        case GasChamberStepStore::kFloat:
+            return valuesF->GetSize();
+        case GasChamberStepStore::kFixedPoint:
+            return valuesI->GetSize();
+        default:
+            return valuesD->GetSize();
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double StepTreeReader::StepColumn::Get(std::size_t i)
+{
+    switch(type)
+    {
+        case GasChamberStepStore::kFloat:
+            return (*valuesF)[i];
+        case GasChamberStepStore::kFixedPoint:
+            return (*valuesI)[i]*scale;
+        default:
+            return (*valuesD)[i];
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......